@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "key_table.hxx"
+
+using namespace std::literals;
+
+// Translates a synthetic stream of SDL keycodes with the generated table and with the
+// unordered_map the engine used before.
+static constexpr std::size_t s_eventCount{ 1'000'000 };
+static constexpr int s_runs{ 10 };
+
+template <typename Translate>
+static std::chrono::nanoseconds measure(const std::vector<SDL_Keycode>& keycodes,
+                                        Translate translate,
+                                        std::uint64_t& checksum) {
+    auto best{ std::chrono::nanoseconds::max() };
+    for (int run{}; run < s_runs; ++run) {
+        const auto start{ std::chrono::steady_clock::now() };
+        std::uint64_t sum{};
+        for (const auto keycode : keycodes)
+            sum += static_cast<std::uint64_t>(translate(keycode));
+        const auto time{ std::chrono::steady_clock::now() - start };
+
+        best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(time));
+        checksum = sum;
+    }
+    return best;
+}
+
+int main() {
+    std::vector<SDL_Keycode> keycodes(s_eventCount);
+    std::mt19937 randomEngine{ 42 };
+    std::uniform_int_distribution<std::size_t> keyDistribution{ 0, key_table::s_keys.size() };
+    for (auto& keycode : keycodes) {
+        // One in s_keys.size() + 1 events is a key the engine doesn't know.
+        const auto index{ keyDistribution(randomEngine) };
+        keycode = index < key_table::s_keys.size() ? key_table::s_keys[index].keycode
+                                                   : SDL_Keycode{ SDLK_SCANCODE_MASK | 300 };
+    }
+
+    std::unordered_map<SDL_Keycode, Event::Keyboard::Key> keymap{};
+    for (const auto& info : key_table::s_keys)
+        keymap.emplace(info.keycode, info.key);
+
+    std::uint64_t mapChecksum{};
+    const auto mapTime{ measure(
+        keycodes,
+        [&keymap](SDL_Keycode keycode) {
+            const auto found{ keymap.find(keycode) };
+            return found != keymap.end() ? found->second : Event::Keyboard::Key::not_key;
+        },
+        mapChecksum) };
+
+    std::uint64_t tableChecksum{};
+    const auto tableTime{ measure(keycodes, key_table::fromKeycode, tableChecksum) };
+
+    if (mapChecksum != tableChecksum) {
+        std::cerr << "Error : key_translation_bench : translations differ\n"sv;
+        return EXIT_FAILURE;
+    }
+
+    const auto perEvent{ [](std::chrono::nanoseconds time) {
+        return static_cast<double>(time.count()) / s_eventCount;
+    } };
+    std::cout << "events: "sv << s_eventCount << ", best of "sv << s_runs << " runs\n"sv
+              << "unordered_map: "sv << perEvent(mapTime) << " ns/event\n"sv
+              << "table:         "sv << perEvent(tableTime) << " ns/event\n"sv;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,183 @@
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "quad_transform.hxx"
+
+using namespace std::literals;
+
+// Builds the quads and bounds of N rotated sprites per frame: the way Sprite does it (a
+// glm::mat3 chain per object, corners and bounds from the matrices) against the SoA kernel.
+static constexpr int s_runs{ 20 };
+
+struct SpriteTransform
+{
+    glm::mat3 moveMatrix{ 1.0f };
+    glm::mat3 scaleMatrix{ 1.0f };
+    glm::mat3 rotationMatrix{ 1.0f };
+    Size size{};
+};
+
+struct Scene
+{
+    std::vector<SpriteTransform> sprites{};
+
+    std::vector<float> positionX{};
+    std::vector<float> positionY{};
+    std::vector<float> rotationSin{};
+    std::vector<float> rotationCos{};
+    std::vector<float> halfWidth{};
+    std::vector<float> halfHeight{};
+    std::vector<std::uint16_t> uvIndices{};
+};
+
+static Scene makeScene(std::size_t count) {
+    Scene scene{};
+    std::mt19937 randomEngine{ 42 };
+    std::uniform_real_distribution<float> position{ -4000.0f, 4000.0f };
+    std::uniform_real_distribution<float> angle{ 0.0f, 2.0f * std::numbers::pi_v<float> };
+    std::uniform_real_distribution<float> size{ 8.0f, 64.0f };
+
+    for (std::size_t i{}; i < count; ++i) {
+        const float x{ position(randomEngine) };
+        const float y{ position(randomEngine) };
+        const float radians{ angle(randomEngine) };
+        const Size spriteSize{ size(randomEngine), size(randomEngine) };
+
+        SpriteTransform sprite{ .size = spriteSize };
+        sprite.moveMatrix[2][0] = x;
+        sprite.moveMatrix[2][1] = y;
+        sprite.rotationMatrix[0][0] = std::cos(radians);
+        sprite.rotationMatrix[0][1] = std::sin(radians);
+        sprite.rotationMatrix[1][0] = -std::sin(radians);
+        sprite.rotationMatrix[1][1] = std::cos(radians);
+        scene.sprites.push_back(sprite);
+
+        scene.positionX.push_back(x);
+        scene.positionY.push_back(y);
+        scene.rotationSin.push_back(std::sin(radians));
+        scene.rotationCos.push_back(std::cos(radians));
+        scene.halfWidth.push_back(spriteSize.width / 2.0f);
+        scene.halfHeight.push_back(spriteSize.height / 2.0f);
+        scene.uvIndices.push_back(0);
+    }
+    return scene;
+}
+
+static void transformSprites(const Scene& scene,
+                             glm::vec2 worldToNdc,
+                             std::vector<Vertex2>& vertices,
+                             std::vector<Rectangle>& bounds) {
+    static constexpr glm::vec3 s_corners[4]{
+        { -0.5f, 0.5f, 1.0f }, { 0.5f, 0.5f, 1.0f }, { 0.5f, -0.5f, 1.0f }, { -0.5f, -0.5f, 1.0f }
+    };
+    static constexpr glm::vec2 s_texCoords[4]{ { 0.0f, 0.0f },
+                                               { 1.0f, 0.0f },
+                                               { 1.0f, 1.0f },
+                                               { 0.0f, 1.0f } };
+
+    for (std::size_t i{}; i < scene.sprites.size(); ++i) {
+        const auto& sprite{ scene.sprites[i] };
+        auto scale{ sprite.scaleMatrix };
+        scale[0][0] *= sprite.size.width;
+        scale[1][1] *= sprite.size.height;
+        // Sprite multiplies move * scale * rotation, rotation * scale keeps the quads rigid so the
+        // results can be compared, the cost is the same.
+        const auto result{ sprite.moveMatrix * sprite.rotationMatrix * scale };
+
+        for (std::size_t corner{}; corner < 4; ++corner) {
+            const auto position{ result * s_corners[corner] };
+            vertices[i * 4 + corner] = { .x = position.x * worldToNdc.x,
+                                         .y = position.y * worldToNdc.y,
+                                         .texX = s_texCoords[corner].x,
+                                         .texY = s_texCoords[corner].y };
+        }
+
+        const auto extent{ sprite.rotationMatrix * scale * glm::vec3{ 1.0f, 1.0f, 1.0f } };
+        const auto center{ sprite.moveMatrix * glm::vec3{ 0.0f, 0.0f, 1.0f } };
+        const Size size{ std::abs(extent.x), std::abs(extent.y) };
+        bounds[i] = { .xy = { center.x - size.width / 2.0f, center.y - size.height / 2.0f },
+                      .wh = size };
+    }
+}
+
+template <typename Run>
+static std::chrono::nanoseconds measure(Run run) {
+    auto best{ std::chrono::nanoseconds::max() };
+    for (int i{}; i < s_runs; ++i) {
+        const auto start{ std::chrono::steady_clock::now() };
+        run();
+        const auto time{ std::chrono::steady_clock::now() - start };
+        best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(time));
+    }
+    return best;
+}
+
+int main() {
+    const glm::vec2 worldToNdc{ 2.0f / 800.0f, 2.0f / 600.0f };
+    const Rectangle uv{ .xy = { 0.0f, 0.0f }, .wh = { 1.0f, 1.0f } };
+
+    std::cout << "best of "sv << s_runs << " runs, kernel: "sv << getQuadTransformIsa() << '\n'
+              << std::setw(8) << "sprites"sv << std::setw(14) << "glm::mat3"sv << std::setw(14)
+              << "scalar"sv << std::setw(14) << "simd"sv << "  (us per frame)\n"sv;
+
+    for (const std::size_t count : { 1'000, 10'000, 100'000 }) {
+        const auto scene{ makeScene(count) };
+
+        std::vector<Vertex2> spriteVertices(count * 4);
+        std::vector<Rectangle> spriteBounds(count);
+        const auto spriteTime{ measure(
+            [&] { transformSprites(scene, worldToNdc, spriteVertices, spriteBounds); }) };
+
+        const QuadTransforms transforms{ .positionX = scene.positionX.data(),
+                                         .positionY = scene.positionY.data(),
+                                         .rotationSin = scene.rotationSin.data(),
+                                         .rotationCos = scene.rotationCos.data(),
+                                         .halfWidth = scene.halfWidth.data(),
+                                         .halfHeight = scene.halfHeight.data(),
+                                         .count = count };
+        const QuadTexCoords texCoords{ .uvs = &uv, .uvIndices = scene.uvIndices.data() };
+
+        std::vector<float> minX(count), minY(count), maxX(count), maxY(count);
+        const QuadBounds bounds{
+            .minX = minX.data(), .minY = minY.data(), .maxX = maxX.data(), .maxY = maxY.data()
+        };
+
+        std::vector<Vertex2> scalarVertices(count * 4);
+        const auto scalarTime{ measure([&] {
+            transformQuadsScalar(transforms, texCoords, worldToNdc, scalarVertices.data(), bounds);
+        }) };
+
+        std::vector<Vertex2> simdVertices(count * 4);
+        const auto simdTime{ measure([&] {
+            transformQuads(transforms, texCoords, worldToNdc, simdVertices.data(), bounds);
+        }) };
+
+        for (std::size_t i{}; i < count * 4; ++i) {
+            const auto& expected{ spriteVertices[i] };
+            const auto& scalar{ scalarVertices[i] };
+            const auto& simd{ simdVertices[i] };
+            if (scalar.x != simd.x || scalar.y != simd.y || scalar.texX != simd.texX ||
+                std::abs(scalar.x - expected.x) > 1e-4f || std::abs(scalar.y - expected.y) > 1e-4f) {
+                std::cerr << "Error : quad_transform_bench : vertex "sv << i << " differs\n"sv;
+                return EXIT_FAILURE;
+            }
+        }
+
+        const auto us{ [](std::chrono::nanoseconds time) {
+            return static_cast<double>(time.count()) / 1000.0;
+        } };
+        std::cout << std::fixed << std::setprecision(1) << std::setw(8) << count << std::setw(14)
+                  << us(spriteTime) << std::setw(14) << us(scalarTime) << std::setw(14)
+                  << us(simdTime) << '\n';
+    }
+    return EXIT_SUCCESS;
+}
@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <iosfwd>
 #include <memory>
+#include <span>
 #include <vector>
 
 struct Vertex
@@ -55,6 +56,12 @@ public:
     void addData(std::vector<V>&& vertices);
     void addData(const std::vector<V>& vertices);
 
+    // Per-frame updates: the returned vertices are written in place, endStream uploads them into
+    // an orphaned GL_STREAM_DRAW store. Valid until endStream, no allocation once the capacity is
+    // reached.
+    [[nodiscard]] std::span<V> beginStream(std::size_t count);
+    void endStream() const;
+
     void clear();
     void bind() const;
     [[nodiscard]] std::size_t size() const noexcept;
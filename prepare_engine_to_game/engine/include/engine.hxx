@@ -8,11 +8,14 @@
 #include <glm/glm.hpp>
 
 #include <array>
+#include <bitset>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <imgui.h>
 #include <iosfwd>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -23,9 +26,10 @@
 #include "texture.hxx"
 #include "view.hxx"
 
+// Tagged union: only the member matching the type is valid.
 struct Event
 {
-    enum class Type
+    enum class Type : std::uint8_t
     {
         key_down,
         key_up,
@@ -38,13 +42,21 @@ struct Event
         touch_motion,
         window_resized,
         turn_off,
+        gamepad_added,
+        gamepad_removed,
+        gamepad_button_down,
+        gamepad_button_up,
+        gamepad_axis,
+        gesture_tap,
+        gesture_pinch,
+        gesture_drag,
 
         not_event,
     };
 
     struct Keyboard
     {
-        enum class Key
+        enum class Key : std::uint8_t
         {
             q,
             w,
@@ -150,7 +162,7 @@ struct Event
 
     struct Mouse
     {
-        enum class Button
+        enum class Button : std::uint8_t
         {
             left,
             right,
@@ -184,17 +196,168 @@ struct Event
         float dy{};
     };
 
+    struct Gamepad
+    {
+        // Positional names, a is the bottom face button whatever the label on the pad.
+        enum class Button : std::uint8_t
+        {
+            a,
+            b,
+            x,
+            y,
+            back,
+            guide,
+            start,
+            left_stick,
+            right_stick,
+            left_shoulder,
+            right_shoulder,
+            dpad_up,
+            dpad_down,
+            dpad_left,
+            dpad_right,
+
+            not_button,
+        };
+
+        enum class Axis : std::uint8_t
+        {
+            left_x,
+            left_y,
+            right_x,
+            right_y,
+            left_trigger,
+            right_trigger,
+
+            not_axis,
+        };
+
+        std::uint32_t id{};
+        Button button{ Button::not_button };
+        Axis axis{ Axis::not_axis };
+        float value{}; // sticks [-1, 1], triggers [0, 1], after the deadzone
+    };
+
+    // Recognized from touches, sent after the touch event that completed the gesture.
+    struct Gesture
+    {
+        Position pos{};     // tap position, pinch center or dragging finger
+        float scale{ 1.0f }; // pinch: finger distance relative to the previous pinch event
+        float dx{};         // drag: offset from where the finger went down
+        float dy{};
+    };
+
+    // New window size in window units.
+    struct Window
+    {
+        int width{};
+        int height{};
+    };
+
     Type type{ Type::not_event };
-    Keyboard keyboard{};
-    Mouse mouse{};
-    Touch touch{};
+    union
+    {
+        Keyboard keyboard{};
+        Mouse mouse;
+        Touch touch;
+        Gamepad gamepad;
+        Gesture gesture;
+        Window window;
+    };
 };
 
 std::ostream& operator<<(std::ostream& out, const Event& event);
 
 std::string_view keyToStr(Event::Keyboard::Key key);
+// Accepts the names returned by keyToStr with or without the trailing '_', not_key if unknown.
+Event::Keyboard::Key strToKey(std::string_view str);
 Event::Keyboard::Key ImGuiKeyToEventKey(ImGuiKey key);
 
+// Input of one frame, filled once per frame by IEngine::pollInput. Key, button and touch states
+// are the states after all events of the frame, pressed/released mark the changes of the frame.
+struct InputState
+{
+    static constexpr std::size_t s_keyCount{ static_cast<std::size_t>(
+        Event::Keyboard::Key::not_key) };
+    static constexpr std::size_t s_buttonCount{ static_cast<std::size_t>(
+        Event::Mouse::Button::not_button) };
+    static constexpr std::size_t s_maxTouches{ 10 };
+    static constexpr std::size_t s_gamepadButtonCount{ static_cast<std::size_t>(
+        Event::Gamepad::Button::not_button) };
+    static constexpr std::size_t s_gamepadAxisCount{ static_cast<std::size_t>(
+        Event::Gamepad::Axis::not_axis) };
+    static constexpr std::size_t s_maxGamepads{ 4 };
+
+    struct TouchPoint
+    {
+        std::size_t id{};
+        Position pos{};
+    };
+
+    struct GamepadState
+    {
+        std::uint32_t id{};
+        std::bitset<s_gamepadButtonCount> buttonsDown{};
+        std::array<float, s_gamepadAxisCount> axes{};
+
+        [[nodiscard]] bool isButtonDown(Event::Gamepad::Button button) const noexcept {
+            return test(buttonsDown, static_cast<std::size_t>(button));
+        }
+
+        [[nodiscard]] float getAxis(Event::Gamepad::Axis axis) const noexcept {
+            const auto index{ static_cast<std::size_t>(axis) };
+            return index < axes.size() ? axes[index] : 0.0f;
+        }
+    };
+
+    std::bitset<s_keyCount> keysDown{};
+    std::bitset<s_keyCount> keysPressed{};
+    std::bitset<s_keyCount> keysReleased{};
+
+    std::bitset<s_buttonCount> buttonsDown{};
+    Event::Mouse::Pos mousePos{};
+    Event::Mouse::Wheel wheel{}; // sum of the wheel events of the frame
+
+    std::array<TouchPoint, s_maxTouches> touches{};
+    std::size_t touchCount{};
+
+    std::array<GamepadState, s_maxGamepads> gamepads{}; // connected pads in connection order
+    std::size_t gamepadCount{};
+
+    std::span<const Event> events{}; // valid until the next pollInput
+    bool isQuitRequested{};
+
+    [[nodiscard]] bool isKeyDown(Event::Keyboard::Key key) const noexcept {
+        return test(keysDown, static_cast<std::size_t>(key));
+    }
+
+    [[nodiscard]] bool wasKeyPressed(Event::Keyboard::Key key) const noexcept {
+        return test(keysPressed, static_cast<std::size_t>(key));
+    }
+
+    [[nodiscard]] bool wasKeyReleased(Event::Keyboard::Key key) const noexcept {
+        return test(keysReleased, static_cast<std::size_t>(key));
+    }
+
+    [[nodiscard]] bool isButtonDown(Event::Mouse::Button button) const noexcept {
+        return test(buttonsDown, static_cast<std::size_t>(button));
+    }
+
+    [[nodiscard]] std::span<const TouchPoint> getTouches() const noexcept {
+        return { touches.data(), touchCount };
+    }
+
+    [[nodiscard]] std::span<const GamepadState> getGamepads() const noexcept {
+        return { gamepads.data(), gamepadCount };
+    }
+
+private:
+    template <std::size_t Size>
+    static bool test(const std::bitset<Size>& bits, std::size_t index) noexcept {
+        return index < Size && bits[index];
+    }
+};
+
 struct Triangle
 {
     std::array<Vertex, 3> vertices{};
@@ -218,10 +381,33 @@ public:
         int height{};
     };
 
+    // Refreshed only when the window is resized or moves to another display. The version changes
+    // with every refresh, values derived from the metrics can be cached against it.
+    struct DisplayMetrics
+    {
+        WindowSize windowSize{};
+        WindowSize pixelSize{};
+        float displayScale{ 1.0f };     // pixels per window unit
+        glm::vec2 windowToNdc{ 1.0f }; // 2 / window size, window units to NDC
+        std::uint64_t version{};
+    };
+
+    // Measured frame intervals, history is a ring of the last frames in milliseconds.
+    struct FrameTimeStats
+    {
+        std::chrono::nanoseconds p50{};
+        std::chrono::nanoseconds p99{};
+        std::chrono::nanoseconds max{};
+        std::span<const float> historyMs{};
+        std::size_t historyOffset{};
+    };
+
     virtual ~IEngine() = default;
     virtual std::string initialize([[maybe_unused]] std::string_view config) = 0;
     virtual void uninitialize() = 0;
-    virtual bool readInput(Event& event) = 0;
+    // Drains all pending events into the snapshot of the frame, call once per frame.
+    virtual const InputState& pollInput() = 0;
+    [[nodiscard]] virtual const InputState& getInputState() const noexcept = 0;
     virtual void swapBuffers() = 0;
     virtual void recompileShaders() = 0;
     virtual void render(const VertexBuffer<Vertex2>& vertexBuffer,
@@ -242,10 +428,32 @@ public:
     virtual void render(const Sprite& sprite) = 0;
     virtual void render(const Sprite& sprite, const View& view) = 0;
     [[nodiscard]] virtual WindowSize getWindowSize() const noexcept = 0;
+    [[nodiscard]] virtual const DisplayMetrics& getDisplayMetrics() const noexcept = 0;
     virtual void setVSync(bool isEnable) = 0;
     [[nodiscard]] virtual bool getVSync() const noexcept = 0;
     virtual void setFramerate(int framerate) = 0;
     [[nodiscard]] virtual int getFramerate() const noexcept = 0;
+    [[nodiscard]] virtual FrameTimeStats getFrameTimeStats() const noexcept = 0;
+    // Offscreen rendering, null audio sink and simulated frame time, see "headless" config key.
+    [[nodiscard]] virtual bool isHeadless() const noexcept = 0;
+    // Seed for gameplay randomness: "random_seed" config key, the seed of a replayed recording,
+    // or a random one. Stays the same for the whole run.
+    [[nodiscard]] virtual std::uint64_t getRandomSeed() const noexcept = 0;
+    // Frame time the simulation of the current frame runs with: the measured one, recorded with
+    // the input, or the recorded one while replaying. Call once per frame after pollInput.
+    virtual std::chrono::nanoseconds resolveFrameTime(std::chrono::nanoseconds measured) = 0;
+    // GPU time of the draw calls between begin and end, reported to the profiler.
+    // Scopes can't nest. No-op when the driver has no timer queries.
+    virtual void beginGpuScope(const char* name) = 0;
+    virtual void endGpuScope() = 0;
+    // 0 disables the fixed-timestep mode, IGame::fixedUpdate is then called once per frame.
+    virtual void setFixedUpdateRate(int updatesPerSecond) = 0;
+    [[nodiscard]] virtual int getFixedUpdateRate() const noexcept = 0;
+    virtual void setMaxFixedUpdateSteps(int maxSteps) = 0;
+    [[nodiscard]] virtual int getMaxFixedUpdateSteps() const noexcept = 0;
+    // Fraction of the axis range around the rest position that reads as 0, [0, 1).
+    virtual void setGamepadDeadzone(float deadzone) = 0;
+    [[nodiscard]] virtual float getGamepadDeadzone() const noexcept = 0;
     [[nodiscard]] virtual ImGuiContext* getImGuiContext() const noexcept = 0;
     [[nodiscard]] virtual std::vector<std::string> getAudioDeviceNames() const noexcept = 0;
     [[nodiscard]] virtual const std::string& getCurrentAudioDeviceName() const noexcept = 0;
@@ -263,14 +471,33 @@ void destroyEngine(IEngine* e);
 
 const EnginePtr& getEngineInstance();
 
+class GpuScope final
+{
+public:
+    explicit GpuScope(const char* name) { getEngineInstance()->beginGpuScope(name); }
+    ~GpuScope() { getEngineInstance()->endGpuScope(); }
+
+    GpuScope(const GpuScope&) = delete;
+    GpuScope& operator=(const GpuScope&) = delete;
+};
+
 class IGame
 {
 public:
     virtual ~IGame() = default;
     virtual void initialize() = 0;
     virtual void onEvent(const Event& event) = 0;
+    // Called once per frame before the fixed steps, the default forwards the events to onEvent.
+    virtual void onInput(const InputState& input) {
+        for (const auto& event : input.events)
+            onEvent(event);
+    }
+    // Simulation step, its duration is constant while the fixed-timestep mode is on.
+    virtual void fixedUpdate(std::chrono::microseconds step) = 0;
+    // Called once per rendered frame after all fixed steps.
     virtual void update() = 0;
-    virtual void render() = 0;
+    // alpha - how far the frame is between the previous and the current fixed step, [0, 1].
+    virtual void render(float alpha) = 0;
 };
 
 extern "C" IGame* createGame(IEngine* engine);
@@ -0,0 +1,107 @@
+#ifndef ENGINE_PREPARE_TO_GAME_ENTITY_STORE_HXX
+#define ENGINE_PREPARE_TO_GAME_ENTITY_STORE_HXX
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "buffer.hxx"
+#include "structures.hxx"
+
+// Many small objects drawn with one texture. Every component lives in its own dense array, so
+// the systems below are tight loops over floats instead of a walk over Sprites. Removing an
+// entity moves the last entity into its place in the arrays.
+//
+// An entity is a handle: the low bits index a slot, the high bits are the generation of the slot.
+// Destroying an entity bumps the generation, so a stale handle stays dead when its slot is reused
+// (until the generation wraps after 256 reuses).
+class EntityStore final
+{
+public:
+    using Entity = std::uint32_t;
+    using RegionId = std::uint16_t;
+
+    static constexpr Entity s_invalidEntity{ std::numeric_limits<Entity>::max() };
+    static constexpr unsigned s_indexBits{ 24 };
+    // The last index is never used, so no entity is s_invalidEntity.
+    static constexpr Entity s_indexMask{ (Entity{ 1 } << s_indexBits) - 1 };
+
+    // Part of the texture an entity is drawn with, size is in world units.
+    struct Region
+    {
+        Size size{};
+        Rectangle uv{ .xy = { 0.0f, 0.0f }, .wh = { 1.0f, 1.0f } };
+    };
+
+private:
+    std::vector<float> m_positionX{};
+    std::vector<float> m_positionY{};
+    std::vector<float> m_velocityX{};
+    std::vector<float> m_velocityY{};
+    std::vector<float> m_rotationSin{};
+    std::vector<float> m_rotationCos{};
+    std::vector<float> m_halfWidth{}; // region size times scale, halved
+    std::vector<float> m_halfHeight{};
+    std::vector<RegionId> m_regionIds{};
+    std::vector<Entity> m_entities{}; // dense index -> entity
+
+    std::vector<std::uint32_t> m_denseIndices{}; // slot -> dense index
+    std::vector<std::uint8_t> m_generations{};   // slot -> generation
+    std::vector<std::uint32_t> m_freeSlots{};
+
+    std::vector<Size> m_regionSizes{};
+    std::vector<Rectangle> m_regionUvs{};
+
+    // Bounds of the rotated quads, refreshed by buildQuads or on the first query after a change.
+    mutable std::vector<float> m_boundsMinX{};
+    mutable std::vector<float> m_boundsMinY{};
+    mutable std::vector<float> m_boundsMaxX{};
+    mutable std::vector<float> m_boundsMaxY{};
+    mutable std::uint64_t m_boundsVersion{};
+
+    std::uint64_t m_version{ 1 };
+
+public:
+    RegionId addRegion(const Region& region);
+    [[nodiscard]] Region getRegion(RegionId id) const;
+
+    Entity create(Position position, RegionId region);
+    void destroy(Entity entity);
+    // Destroys every entity, their handles stay dead.
+    void clear();
+
+    [[nodiscard]] bool isAlive(Entity entity) const noexcept;
+    [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+
+    void setPosition(Entity entity, Position position);
+    [[nodiscard]] Position getPosition(Entity entity) const;
+    void setVelocity(Entity entity, Position velocity);
+    void setRotation(Entity entity, float radians);
+    void setScale(Entity entity, Scale scale);
+
+    // Changes with every change of the store, cached draw data can be rebuilt only when needed.
+    [[nodiscard]] std::uint64_t getVersion() const noexcept;
+
+    // Moves every entity by its velocity.
+    void integrate(float dt) noexcept;
+
+    // First entity whose bounding box touches the rectangle.
+    [[nodiscard]] std::optional<Entity> findOverlap(const Rectangle& rectangle) const noexcept;
+
+    // Writes 4 vertices per entity in dense order (vertices.size() must be size() * 4), world
+    // positions are multiplied by worldToNdc. SIMD, see transformQuads.
+    void buildQuads(glm::vec2 worldToNdc, std::span<Vertex2> vertices) const;
+    // Two triangles per quad of buildQuads.
+    static void buildQuadIndices(std::size_t quadCount, std::vector<std::uint32_t>& indices);
+
+private:
+    [[nodiscard]] std::uint32_t getDenseIndex(Entity entity) const;
+    void updateBounds() const noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_ENTITY_STORE_HXX
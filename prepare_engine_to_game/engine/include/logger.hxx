@@ -0,0 +1,186 @@
+#ifndef ENGINE_PREPARE_TO_GAME_LOGGER_HXX
+#define ENGINE_PREPARE_TO_GAME_LOGGER_HXX
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+enum class LogLevel : std::uint8_t
+{
+    trace,
+    debug,
+    info,
+    warning,
+    error,
+    off,
+};
+
+// Messages below ENGINE_LOG_LEVEL are compiled out: 0 trace, 1 debug, 2 info, 3 warning, 4 error,
+// 5 off. Above it the runtime level (Logger::setLevel) filters before any argument is evaluated.
+#ifndef ENGINE_LOG_LEVEL
+#    ifdef NDEBUG
+#        define ENGINE_LOG_LEVEL 2
+#    else
+#        define ENGINE_LOG_LEVEL 1
+#    endif
+#endif
+
+// Structured field, printed as key=value after the message.
+struct LogField
+{
+    enum class Type : std::uint8_t
+    {
+        integer,
+        unsigned_integer,
+        floating,
+        boolean,
+        string,
+    };
+
+    std::string_view key{};
+    Type type{};
+    union
+    {
+        std::int64_t integer;
+        std::uint64_t unsignedInteger;
+        double floating;
+        bool boolean;
+    };
+    std::string_view string{};
+
+    LogField(std::string_view fieldKey, bool value) noexcept
+        : key{ fieldKey }
+        , type{ Type::boolean }
+        , boolean{ value } {}
+
+    template <typename T>
+        requires std::is_integral_v<T> && std::is_signed_v<T>
+    LogField(std::string_view fieldKey, T value) noexcept
+        : key{ fieldKey }
+        , type{ Type::integer }
+        , integer{ value } {}
+
+    template <typename T>
+        requires std::is_integral_v<T> && std::is_unsigned_v<T> && (!std::is_same_v<T, bool>)
+    LogField(std::string_view fieldKey, T value) noexcept
+        : key{ fieldKey }
+        , type{ Type::unsigned_integer }
+        , unsignedInteger{ value } {}
+
+    template <typename T>
+        requires std::is_floating_point_v<T>
+    LogField(std::string_view fieldKey, T value) noexcept
+        : key{ fieldKey }
+        , type{ Type::floating }
+        , floating{ value } {}
+
+    // The string is copied into the log record, it doesn't have to outlive the call.
+    LogField(std::string_view fieldKey, std::string_view value) noexcept
+        : key{ fieldKey }
+        , type{ Type::string }
+        , integer{}
+        , string{ value } {}
+
+    LogField(std::string_view fieldKey, const char* value) noexcept
+        : LogField{ fieldKey, std::string_view{ value } } {}
+
+    LogField(std::string_view fieldKey, const std::string& value) noexcept
+        : LogField{ fieldKey, std::string_view{ value } } {}
+};
+
+// Asynchronous logger. The calling thread only formats the record into its own lock-free ring,
+// a background thread writes the rings to std::clog. A full ring drops records instead of
+// blocking, the number of dropped records is reported with the next write.
+class Logger final
+{
+private:
+    struct Record
+    {
+        static constexpr std::size_t s_maxTextSize{ 240 };
+
+        std::int64_t timestampUs{};
+        std::uint32_t threadId{};
+        LogLevel level{};
+        std::uint8_t textSize{};
+        std::array<char, s_maxTextSize> text{};
+    };
+
+    struct ThreadBuffer
+    {
+        static constexpr std::size_t s_capacity{ 512 };
+
+        std::array<Record, s_capacity> records{};
+        alignas(64) std::atomic<std::size_t> head{};
+        alignas(64) std::atomic<std::size_t> tail{};
+        std::atomic<std::uint64_t> dropped{};
+        std::uint32_t threadId{};
+    };
+
+    const std::chrono::steady_clock::time_point m_start{ std::chrono::steady_clock::now() };
+    std::atomic<LogLevel> m_level{ LogLevel::info };
+
+    std::mutex m_buffersMutex{};
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers{};
+
+    // Consumer side of every ring: the background thread and flush() must not interleave.
+    std::mutex m_drainMutex{};
+    std::vector<Record> m_drainRecords{};
+
+    std::atomic<std::uint32_t> m_pending{};
+    std::atomic<bool> m_isRunning{ true };
+    std::thread m_thread{};
+
+public:
+    static Logger& getInstance();
+
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void setLevel(LogLevel level) noexcept;
+    [[nodiscard]] LogLevel getLevel() const noexcept;
+    [[nodiscard]] bool isEnabled(LogLevel level) const noexcept;
+
+    void log(LogLevel level, std::string_view message, std::initializer_list<LogField> fields);
+
+    // Blocks until everything logged before the call is written.
+    void flush();
+
+    static std::string_view levelToStr(LogLevel level) noexcept;
+    // Throws on an unknown name.
+    static LogLevel strToLevel(std::string_view str);
+
+private:
+    Logger();
+
+    ThreadBuffer& getThreadBuffer();
+    void run();
+    void drain();
+};
+
+#define ENGINE_LOG(level, message, ...)                                                     \
+    do {                                                                                    \
+        if constexpr (static_cast<int>(level) >= ENGINE_LOG_LEVEL) {                        \
+            if (Logger::getInstance().isEnabled(level))                                     \
+                Logger::getInstance().log(level, message, { __VA_ARGS__ });                 \
+        }                                                                                   \
+    } while (false)
+
+#define LOG_TRACE(message, ...) ENGINE_LOG(LogLevel::trace, message __VA_OPT__(, ) __VA_ARGS__)
+#define LOG_DEBUG(message, ...) ENGINE_LOG(LogLevel::debug, message __VA_OPT__(, ) __VA_ARGS__)
+#define LOG_INFO(message, ...) ENGINE_LOG(LogLevel::info, message __VA_OPT__(, ) __VA_ARGS__)
+#define LOG_WARNING(message, ...) \
+    ENGINE_LOG(LogLevel::warning, message __VA_OPT__(, ) __VA_ARGS__)
+#define LOG_ERROR(message, ...) ENGINE_LOG(LogLevel::error, message __VA_OPT__(, ) __VA_ARGS__)
+
+#endif // ENGINE_PREPARE_TO_GAME_LOGGER_HXX
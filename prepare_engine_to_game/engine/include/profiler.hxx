@@ -0,0 +1,164 @@
+#ifndef ENGINE_PREPARE_TO_GAME_PROFILER_HXX
+#define ENGINE_PREPARE_TO_GAME_PROFILER_HXX
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// Set ENGINE_PROFILER_ENABLED to 0 to compile all zones out.
+#ifndef ENGINE_PROFILER_ENABLED
+#    define ENGINE_PROFILER_ENABLED 1
+#endif
+
+class Profiler final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Zone
+    {
+        // Only has to stay valid until the next newFrame, captured frames hold interned copies.
+        const char* name{};
+        std::int64_t startNs{};
+        std::int64_t endNs{};
+        std::uint32_t threadId{};
+        std::uint32_t depth{};
+    };
+
+    struct GpuZone
+    {
+        const char* name{}; // interned
+        std::int64_t durationNs{};
+    };
+
+    struct Frame
+    {
+        std::int64_t startNs{};
+        std::int64_t endNs{};
+        std::vector<Zone> zones{};
+        std::vector<GpuZone> gpuZones{}; // results arrive a frame or two after the work was issued
+    };
+
+    class ScopedZone final
+    {
+    private:
+        const char* m_name{};
+        std::int64_t m_startNs{};
+        bool m_isActive{};
+
+    public:
+        explicit ScopedZone(const char* name) noexcept;
+        ~ScopedZone();
+
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+    };
+
+private:
+    // Single producer (owning thread) / single consumer (newFrame) ring, the producer never
+    // blocks: when the ring is full the zone is dropped and counted.
+    struct ThreadBuffer
+    {
+        static constexpr std::size_t s_capacity{ 4096 };
+
+        std::array<Zone, s_capacity> zones{};
+        alignas(64) std::atomic<std::size_t> head{};
+        alignas(64) std::atomic<std::size_t> tail{};
+        std::atomic<std::uint64_t> dropped{};
+        std::uint32_t threadId{};
+        std::uint32_t depth{};
+    };
+
+    static constexpr std::size_t s_maxCapturedFrames{ 300 };
+    static constexpr std::uint32_t s_gpuTrackId{ 1000 };
+
+    const Clock::time_point m_epoch{ Clock::now() };
+    std::atomic<bool> m_isEnabled{ true };
+
+    std::mutex m_buffersMutex{};
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers{};
+
+    struct NameHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    // Names of the captured zones. Zones of the game point into its shared library, which is
+    // unloaded on hot reload while its zones are still in the history.
+    std::unordered_set<std::string, NameHash, std::equal_to<>> m_names{};
+
+    std::deque<Frame> m_frames{};
+    Frame m_currentFrame{};
+    std::uint64_t m_droppedZones{};
+
+    bool m_isGpuTimingAvailable{};
+
+    bool m_isWindowVisible{};
+    bool m_isPaused{};
+
+public:
+    static Profiler& getInstance();
+
+    void setEnabled(bool isEnabled) noexcept;
+    [[nodiscard]] bool isEnabled() const noexcept;
+
+    [[nodiscard]] std::int64_t now() const noexcept;
+
+    // Closes the current frame: collects zones from all threads. Call from the main thread once
+    // per frame.
+    void newFrame();
+
+    [[nodiscard]] const std::deque<Frame>& getFrames() const noexcept;
+
+    // Zone measured outside a ScopedZone, e.g. from an OS timestamp converted with now().
+    void recordZone(const char* name, std::int64_t startNs, std::int64_t endNs) noexcept;
+
+    // GPU timings are measured by the engine and attached to the current frame, main thread only.
+    void setGpuTimingAvailable(bool isAvailable) noexcept;
+    [[nodiscard]] bool isGpuTimingAvailable() const noexcept;
+    void recordGpuZone(const char* name, std::int64_t durationNs);
+
+    // Copy of the name owned by the profiler, for names that have to outlive the code that
+    // recorded them. Main thread only.
+    [[nodiscard]] const char* intern(std::string_view name);
+
+    void setWindowVisible(bool isVisible) noexcept;
+    [[nodiscard]] bool isWindowVisible() const noexcept;
+
+    // Timeline of the last closed frame, one lane per thread.
+    void drawImGui();
+
+    // Writes captured frames in the Chrome trace_event format (chrome://tracing, Perfetto).
+    void dumpChromeTrace(const std::filesystem::path& path) const;
+
+private:
+    Profiler() = default;
+
+    ThreadBuffer& getThreadBuffer();
+    void push(ThreadBuffer& buffer, const Zone& zone) noexcept;
+};
+
+#if ENGINE_PROFILER_ENABLED
+#    define ENGINE_PROFILE_CONCAT_IMPL(a, b) a##b
+#    define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_IMPL(a, b)
+#    define ENGINE_PROFILE_SCOPE(name) \
+        const Profiler::ScopedZone ENGINE_PROFILE_CONCAT(profileZone, __LINE__) { name }
+#    define ENGINE_PROFILE_FUNCTION() ENGINE_PROFILE_SCOPE(__func__)
+#else
+#    define ENGINE_PROFILE_SCOPE(name)
+#    define ENGINE_PROFILE_FUNCTION()
+#endif
+
+#endif // ENGINE_PREPARE_TO_GAME_PROFILER_HXX
@@ -2,6 +2,7 @@
 #define VERTEX_MORPHING_SPRITE_HXX
 #include <glm/glm.hpp>
 
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -25,14 +26,24 @@ private:
     glm::mat3 m_aspectMatrix{ 0.0f };
     glm::mat3 m_rotationMatrix{ 0.0f };
 
+    // Window size the aspect matrix was computed for, refreshed when the display metrics change.
     int m_windowWidth{};
     int m_windowHeight{};
+    std::uint64_t m_metricsVersion{};
 
     inline static Size s_originalWindowSize{};
 
     std::vector<Vertex2> m_vertices{};
     std::vector<uint16_t> m_indices{};
 
+    // Derived from the matrices on first use after a change, the rectangle also depends on the
+    // window size the position is converted with.
+    mutable glm::mat3 m_resultMatrix{ 1.0f };
+    mutable Position m_worldPosition{};
+    mutable Rectangle m_rectangle{};
+    mutable std::uint64_t m_cacheVersion{};
+    mutable bool m_isDirty{ true };
+
 public:
     explicit Sprite(Size size);
     explicit Sprite(const fs::path& texturePath);
@@ -62,13 +73,15 @@ public:
     [[nodiscard]] const std::vector<Vertex2>& getVertices() const noexcept;
     [[nodiscard]] const std::vector<uint16_t>& getIndices() const noexcept;
     [[nodiscard]] const Texture& getTexture() const noexcept;
-    [[nodiscard]] glm::mat3 getResultMatrix() const noexcept;
-    [[nodiscard]] Rectangle getRectangle() const noexcept;
+    [[nodiscard]] const glm::mat3& getResultMatrix() const noexcept;
+    [[nodiscard]] const Rectangle& getRectangle() const noexcept;
 
     static void setOriginalSize(Size size);
 
 private:
     void initialize();
+    void syncCache() const noexcept;
+    void updateCache() const noexcept;
 };
 
 std::optional<Rectangle> intersect(const Sprite& s1, const Sprite& s2);
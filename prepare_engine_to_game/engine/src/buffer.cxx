@@ -73,6 +73,23 @@ void VertexBuffer<V>::addData(const std::vector<V>& vertices) {
     updateData();
 }
 
+template <typename V>
+std::span<V> VertexBuffer<V>::beginStream(std::size_t count) {
+    m_vertices.resize(count);
+    return m_vertices;
+}
+
+template <typename V>
+void VertexBuffer<V>::endStream() const {
+    bind();
+
+    const auto bytes{ static_cast<GLsizeiptr>(m_vertices.size() * sizeof(V)) };
+    glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+    openGLCheck();
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, m_vertices.data());
+    openGLCheck();
+}
+
 template <typename V>
 void VertexBuffer<V>::clear() {
     m_vertices.clear();
@@ -3,21 +3,34 @@
 #include <glm/glm.hpp>
 
 #include <SDL3/SDL.h>
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <glad/glad.h>
 #include <iostream>
 #include <mutex>
 #include <optional>
+#include <random>
 #include <stdexcept>
 #include <thread>
 #include <unordered_map>
 
+#include "fixed_timestep.hxx"
+#include "frame_pacer.hxx"
+#include "gamepad.hxx"
+#include "gpu_timer.hxx"
 #include "hot_reload_provider.hxx"
 #include "imgui_impl_opengl3.hxx"
 #include "imgui_impl_sdl3.hxx"
+#include "input_recording.hxx"
+#include "input_script.hxx"
+#include "key_table.hxx"
+#include "logger.hxx"
 #include "opengl_check.hxx"
+#include "profiler.hxx"
+#include "touch_tracker.hxx"
 
 #ifndef __ANDROID__
 #    include <boost/json.hpp>
@@ -33,294 +46,149 @@ namespace json = boost::json;
 using namespace std::literals;
 namespace fs = std::filesystem;
 
-static const std::unordered_map<Event::Type, std::string_view> s_eventTypeToStringView{
-    { Event::Type::key_down, "key_down" },
-    { Event::Type::key_up, "key_up" },
-    { Event::Type::mouse_down, "button_down" },
-    { Event::Type::mouse_up, "button_up" },
-    { Event::Type::mouse_wheel, "spin_wheel" },
-    { Event::Type::mouse_motion, "mouse_motion" },
-    { Event::Type::touch_down, "touch_down" },
-    { Event::Type::touch_up, "touch_up" },
-    { Event::Type::touch_motion, "touch_motion" },
-    { Event::Type::window_resized, "window_resized" },
-    { Event::Type::turn_off, "turn_off" },
-    { Event::Type::not_event, "" }
-};
-
-static const std::unordered_map<Event::Keyboard::Key, std::string_view> s_eventKeysToStringView{
-    { Event::Keyboard::Key::q, "q_" },
-    { Event::Keyboard::Key::w, "w_" },
-    { Event::Keyboard::Key::e, "e_" },
-    { Event::Keyboard::Key::r, "r_" },
-    { Event::Keyboard::Key::t, "t_" },
-    { Event::Keyboard::Key::y, "y_" },
-    { Event::Keyboard::Key::u, "u_" },
-    { Event::Keyboard::Key::i, "i_" },
-    { Event::Keyboard::Key::o, "o_" },
-    { Event::Keyboard::Key::p, "p_" },
-    { Event::Keyboard::Key::a, "a_" },
-    { Event::Keyboard::Key::s, "s_" },
-    { Event::Keyboard::Key::d, "d_" },
-    { Event::Keyboard::Key::f, "f_" },
-    { Event::Keyboard::Key::g, "g_" },
-    { Event::Keyboard::Key::h, "h_" },
-    { Event::Keyboard::Key::j, "j_" },
-    { Event::Keyboard::Key::k, "k_" },
-    { Event::Keyboard::Key::l, "l_" },
-    { Event::Keyboard::Key::z, "z_" },
-    { Event::Keyboard::Key::x, "x_" },
-    { Event::Keyboard::Key::c, "c_" },
-    { Event::Keyboard::Key::v, "v_" },
-    { Event::Keyboard::Key::b, "b_" },
-    { Event::Keyboard::Key::n, "n_" },
-    { Event::Keyboard::Key::m, "m_" },
-    { Event::Keyboard::Key::space, "space_" },
-    { Event::Keyboard::Key::enter, "enter_" },
-    { Event::Keyboard::Key::l_control, "left_control_" },
-    { Event::Keyboard::Key::l_shift, "left_shift_" },
-    { Event::Keyboard::Key::escape, "escape_" },
-    { Event::Keyboard::Key::backspace, "backspace_" },
-
-    // Number keys
-    { Event::Keyboard::Key::num_0, "num_0_" },
-    { Event::Keyboard::Key::num_1, "num_1_" },
-    { Event::Keyboard::Key::num_2, "num_2_" },
-    { Event::Keyboard::Key::num_3, "num_3_" },
-    { Event::Keyboard::Key::num_4, "num_4_" },
-    { Event::Keyboard::Key::num_5, "num_5_" },
-    { Event::Keyboard::Key::num_6, "num_6_" },
-    { Event::Keyboard::Key::num_7, "num_7_" },
-    { Event::Keyboard::Key::num_8, "num_8_" },
-    { Event::Keyboard::Key::num_9, "num_9_" },
-
-    // Function keys
-    { Event::Keyboard::Key::f1, "f1_" },
-    { Event::Keyboard::Key::f2, "f2_" },
-    { Event::Keyboard::Key::f3, "f3_" },
-    { Event::Keyboard::Key::f4, "f4_" },
-    { Event::Keyboard::Key::f5, "f5_" },
-    { Event::Keyboard::Key::f6, "f6_" },
-    { Event::Keyboard::Key::f7, "f7_" },
-    { Event::Keyboard::Key::f8, "f8_" },
-    { Event::Keyboard::Key::f9, "f9_" },
-    { Event::Keyboard::Key::f10, "f10_" },
-    { Event::Keyboard::Key::f11, "f11_" },
-    { Event::Keyboard::Key::f12, "f12_" },
-
-    // Arrow keys
-    { Event::Keyboard::Key::up_arrow, "up_arrow_" },
-    { Event::Keyboard::Key::down_arrow, "down_arrow_" },
-    { Event::Keyboard::Key::left_arrow, "left_arrow_" },
-    { Event::Keyboard::Key::right_arrow, "right_arrow_" },
-
-    // Miscellaneous keys
-    { Event::Keyboard::Key::insert, "insert_" },
-    { Event::Keyboard::Key::home, "home_" },
-    { Event::Keyboard::Key::page_up, "page_up_" },
-    { Event::Keyboard::Key::delete_key, "delete_key_" },
-    { Event::Keyboard::Key::end, "end_" },
-    { Event::Keyboard::Key::page_down, "page_down_" },
-    { Event::Keyboard::Key::caps_lock, "caps_lock_" },
-    { Event::Keyboard::Key::scroll_lock, "scroll_lock_" },
-    { Event::Keyboard::Key::num_lock, "num_lock_" },
-    { Event::Keyboard::Key::print_screen, "print_screen_" },
-    { Event::Keyboard::Key::pause, "pause_" },
-
-    // Numpad keys
-    { Event::Keyboard::Key::numpad_0, "numpad_0_" },
-    { Event::Keyboard::Key::numpad_1, "numpad_1_" },
-    { Event::Keyboard::Key::numpad_2, "numpad_2_" },
-    { Event::Keyboard::Key::numpad_3, "numpad_3_" },
-    { Event::Keyboard::Key::numpad_4, "numpad_4_" },
-    { Event::Keyboard::Key::numpad_5, "numpad_5_" },
-    { Event::Keyboard::Key::numpad_6, "numpad_6_" },
-    { Event::Keyboard::Key::numpad_7, "numpad_7_" },
-    { Event::Keyboard::Key::numpad_8, "numpad_8_" },
-    { Event::Keyboard::Key::numpad_9, "numpad_9_" },
-    { Event::Keyboard::Key::numpad_decimal, "numpad_decimal_" },
-    { Event::Keyboard::Key::numpad_divide, "numpad_divide_" },
-    { Event::Keyboard::Key::numpad_multiply, "numpad_multiply_" },
-    { Event::Keyboard::Key::numpad_subtract, "numpad_subtract_" },
-    { Event::Keyboard::Key::numpad_add, "numpad_add_" },
-    { Event::Keyboard::Key::numpad_enter, "numpad_enter_" },
-
-    { Event::Keyboard::Key::not_key, "" }
-};
+static constexpr std::array<std::string_view, static_cast<std::size_t>(Event::Type::not_event) + 1>
+    s_eventTypeNames{ "key_down",
+                      "key_up",
+                      "button_down",
+                      "button_up",
+                      "spin_wheel",
+                      "mouse_motion",
+                      "touch_down",
+                      "touch_up",
+                      "touch_motion",
+                      "window_resized",
+                      "turn_off",
+                      "gamepad_added",
+                      "gamepad_removed",
+                      "gamepad_button_down",
+                      "gamepad_button_up",
+                      "gamepad_axis",
+                      "gesture_tap",
+                      "gesture_pinch",
+                      "gesture_drag",
+                      "" };
+
+static constexpr std::array<std::string_view,
+                            static_cast<std::size_t>(Event::Mouse::Button::not_button) + 1>
+    s_eventButtonNames{ "left_", "right_", "middle_", "" };
+
+static std::string_view eventTypeToStr(Event::Type type) {
+    return s_eventTypeNames[static_cast<std::size_t>(type)];
+}
 
-static const std::unordered_map<Event::Mouse::Button, std::string_view> s_eventButtonsToStringView{
-    { Event::Mouse::Button::left, "left_" },
-    { Event::Mouse::Button::right, "right_" },
-    { Event::Mouse::Button::middle, "middle_" },
-    { Event::Mouse::Button::not_button, "" }
-};
+static std::string_view buttonToStr(Event::Mouse::Button button) {
+    return s_eventButtonNames[static_cast<std::size_t>(button)];
+}
 
 std::ostream& operator<<(std::ostream& out, const Event& event) {
-    out << s_eventKeysToStringView.at(event.keyboard.key)
-        << s_eventButtonsToStringView.at(event.mouse.button)
-        << s_eventTypeToStringView.at(event.type);
+    switch (event.type) {
+    case Event::Type::key_down:
+    case Event::Type::key_up:
+        out << keyToStr(event.keyboard.key);
+        break;
+
+    case Event::Type::mouse_down:
+    case Event::Type::mouse_up:
+        out << buttonToStr(event.mouse.button);
+        break;
+
+    default:
+        break;
+    }
+    out << eventTypeToStr(event.type);
 
     return out;
 }
 
-std::string_view keyToStr(Event::Keyboard::Key key) { return s_eventKeysToStringView.at(key); }
-
-Event::Keyboard::Key ImGuiKeyToEventKey(ImGuiKey key) {
-    switch (key) {
-    case ImGuiKey_LeftArrow:
-        return Event::Keyboard::Key::left_arrow;
-    case ImGuiKey_RightArrow:
-        return Event::Keyboard::Key::right_arrow;
-    case ImGuiKey_UpArrow:
-        return Event::Keyboard::Key::up_arrow;
-    case ImGuiKey_DownArrow:
-        return Event::Keyboard::Key::down_arrow;
-    case ImGuiKey_KeyPadEnter:
-        return Event::Keyboard::Key::numpad_enter;
-    case ImGuiKey_KeypadMultiply:
-        return Event::Keyboard::Key::numpad_multiply;
-    case ImGuiKey_KeypadAdd:
-        return Event::Keyboard::Key::numpad_add;
-    case ImGuiKey_KeypadSubtract:
-        return Event::Keyboard::Key::numpad_subtract;
-    case ImGuiKey_KeypadDivide:
-        return Event::Keyboard::Key::numpad_divide;
-    case ImGuiKey_0:
-        return Event::Keyboard::Key::num_0;
-    case ImGuiKey_1:
-        return Event::Keyboard::Key::num_1;
-    case ImGuiKey_2:
-        return Event::Keyboard::Key::num_2;
-    case ImGuiKey_3:
-        return Event::Keyboard::Key::num_3;
-    case ImGuiKey_4:
-        return Event::Keyboard::Key::num_4;
-    case ImGuiKey_5:
-        return Event::Keyboard::Key::num_5;
-    case ImGuiKey_6:
-        return Event::Keyboard::Key::num_6;
-    case ImGuiKey_7:
-        return Event::Keyboard::Key::num_7;
-    case ImGuiKey_8:
-        return Event::Keyboard::Key::num_8;
-    case ImGuiKey_9:
-        return Event::Keyboard::Key::num_9;
-    case ImGuiKey_F1:
-        return Event::Keyboard::Key::f1;
-    case ImGuiKey_F2:
-        return Event::Keyboard::Key::f2;
-    case ImGuiKey_F3:
-        return Event::Keyboard::Key::f3;
-    case ImGuiKey_F4:
-        return Event::Keyboard::Key::f4;
-    case ImGuiKey_F5:
-        return Event::Keyboard::Key::f5;
-    case ImGuiKey_F6:
-        return Event::Keyboard::Key::f6;
-    case ImGuiKey_F7:
-        return Event::Keyboard::Key::f7;
-    case ImGuiKey_F8:
-        return Event::Keyboard::Key::f8;
-    case ImGuiKey_F9:
-        return Event::Keyboard::Key::f9;
-    case ImGuiKey_F10:
-        return Event::Keyboard::Key::f10;
-    case ImGuiKey_F11:
-        return Event::Keyboard::Key::f11;
-    case ImGuiKey_F12:
-        return Event::Keyboard::Key::f12;
-    case ImGuiKey_Pause:
-        return Event::Keyboard::Key::pause;
-    case ImGuiKey_Backspace:
-        return Event::Keyboard::Key::backspace;
-    case ImGuiKey_Enter:
-        return Event::Keyboard::Key::enter;
-    case ImGuiKey_Escape:
-        return Event::Keyboard::Key::escape;
-    case ImGuiKey_A:
-        return Event::Keyboard::Key::a;
-    case ImGuiKey_B:
-        return Event::Keyboard::Key::b;
-    case ImGuiKey_C:
-        return Event::Keyboard::Key::c;
-
-    case ImGuiKey_D:
-        return Event::Keyboard::Key::d;
-    case ImGuiKey_E:
-        return Event::Keyboard::Key::e;
-    case ImGuiKey_F:
-        return Event::Keyboard::Key::f;
-    case ImGuiKey_G:
-        return Event::Keyboard::Key::g;
-    case ImGuiKey_H:
-        return Event::Keyboard::Key::h;
-    case ImGuiKey_I:
-        return Event::Keyboard::Key::i;
-    case ImGuiKey_J:
-        return Event::Keyboard::Key::j;
-    case ImGuiKey_K:
-        return Event::Keyboard::Key::k;
-    case ImGuiKey_L:
-        return Event::Keyboard::Key::l;
-    case ImGuiKey_M:
-        return Event::Keyboard::Key::m;
-    case ImGuiKey_N:
-        return Event::Keyboard::Key::n;
-    case ImGuiKey_O:
-        return Event::Keyboard::Key::o;
-    case ImGuiKey_P:
-        return Event::Keyboard::Key::p;
-    case ImGuiKey_Q:
-        return Event::Keyboard::Key::q;
-    case ImGuiKey_R:
-        return Event::Keyboard::Key::r;
-    case ImGuiKey_S:
-        return Event::Keyboard::Key::s;
-    case ImGuiKey_T:
-        return Event::Keyboard::Key::t;
-    case ImGuiKey_U:
-        return Event::Keyboard::Key::u;
-    case ImGuiKey_V:
-        return Event::Keyboard::Key::v;
-    case ImGuiKey_W:
-        return Event::Keyboard::Key::w;
-    case ImGuiKey_X:
-        return Event::Keyboard::Key::x;
-    case ImGuiKey_Y:
-        return Event::Keyboard::Key::y;
-    case ImGuiKey_Z:
-        return Event::Keyboard::Key::z;
-    case ImGuiKey_Space:
-        return Event::Keyboard::Key::space;
-    case ImGuiKey_Insert:
-        return Event::Keyboard::Key::insert;
-    case ImGuiKey_Home:
-        return Event::Keyboard::Key::home;
-    case ImGuiKey_PageUp:
-        return Event::Keyboard::Key::page_up;
-    case ImGuiKey_Delete:
-        return Event::Keyboard::Key::delete_key;
-    case ImGuiKey_End:
-        return Event::Keyboard::Key::end;
-    case ImGuiKey_PageDown:
-        return Event::Keyboard::Key::page_down;
-    case ImGuiKey_CapsLock:
-        return Event::Keyboard::Key::caps_lock;
-    case ImGuiKey_ScrollLock:
-        return Event::Keyboard::Key::scroll_lock;
-    case ImGuiKey_NumLock:
-        return Event::Keyboard::Key::num_lock;
-    case ImGuiKey_PrintScreen:
-        return Event::Keyboard::Key::print_screen;
-    case ImGuiKey_LeftShift:
-        return Event::Keyboard::Key::l_shift;
-    case ImGuiKey_LeftCtrl:
-        return Event::Keyboard::Key::l_control;
+std::string_view keyToStr(Event::Keyboard::Key key) { return key_table::toName(key); }
+
+Event::Keyboard::Key strToKey(std::string_view str) {
+    for (const auto& info : key_table::s_keys) {
+        const auto name{ info.name };
+        if (name == str || (name.size() == str.size() + 1 && name.starts_with(str)))
+            return info.key;
+    }
+    return Event::Keyboard::Key::not_key;
+}
+
+// Compiles to nothing below the debug level except the rare gamepad hot plug messages, the
+// input loop does no formatting or I/O.
+static void logEvent([[maybe_unused]] const Event& event) {
+    switch (event.type) {
+    case Event::Type::key_down:
+    case Event::Type::key_up:
+        LOG_DEBUG("input event",
+                  { "type", eventTypeToStr(event.type) },
+                  { "key", keyToStr(event.keyboard.key) });
+        break;
+
+    case Event::Type::mouse_down:
+    case Event::Type::mouse_up:
+    case Event::Type::mouse_motion:
+        LOG_DEBUG("input event",
+                  { "type", eventTypeToStr(event.type) },
+                  { "button", buttonToStr(event.mouse.button) },
+                  { "x", event.mouse.pos.x },
+                  { "y", event.mouse.pos.y });
+        break;
+
+    case Event::Type::touch_down:
+    case Event::Type::touch_up:
+    case Event::Type::touch_motion:
+        LOG_DEBUG("input event",
+                  { "type", eventTypeToStr(event.type) },
+                  { "id", event.touch.id },
+                  { "x", event.touch.pos.x },
+                  { "y", event.touch.pos.y });
+        break;
+
+    case Event::Type::gamepad_button_down:
+    case Event::Type::gamepad_button_up:
+        LOG_DEBUG("input event",
+                  { "type", eventTypeToStr(event.type) },
+                  { "id", event.gamepad.id },
+                  { "button", static_cast<unsigned>(event.gamepad.button) });
+        break;
+
+    case Event::Type::gamepad_axis:
+        LOG_DEBUG("input event",
+                  { "type", eventTypeToStr(event.type) },
+                  { "id", event.gamepad.id },
+                  { "axis", static_cast<unsigned>(event.gamepad.axis) },
+                  { "value", event.gamepad.value });
+        break;
+
+    case Event::Type::gesture_tap:
+    case Event::Type::gesture_pinch:
+        LOG_DEBUG("input event",
+                  { "type", eventTypeToStr(event.type) },
+                  { "x", event.gesture.pos.x },
+                  { "y", event.gesture.pos.y },
+                  { "scale", event.gesture.scale });
+        break;
+
+    case Event::Type::gesture_drag:
+        LOG_DEBUG("input event",
+                  { "type", eventTypeToStr(event.type) },
+                  { "x", event.gesture.pos.x },
+                  { "y", event.gesture.pos.y },
+                  { "dx", event.gesture.dx },
+                  { "dy", event.gesture.dy });
+        break;
+
+    case Event::Type::gamepad_added:
+    case Event::Type::gamepad_removed:
+        LOG_INFO("gamepad", { "type", eventTypeToStr(event.type) }, { "id", event.gamepad.id });
+        break;
+
     default:
-        return Event::Keyboard::Key::not_key;
+        LOG_DEBUG("input event", { "type", eventTypeToStr(event.type) });
+        break;
     }
 }
 
+Event::Keyboard::Key ImGuiKeyToEventKey(ImGuiKey key) { return key_table::fromImGuiKey(key); }
+
 std::ifstream& operator>>(std::ifstream& in, Triangle& triangle) {
     for (auto& vertex : triangle.vertices)
         in >> vertex;
@@ -336,111 +204,10 @@ std::ifstream& operator>>(std::ifstream& in, Triangle2& triangle2) {
 }
 
 static std::optional<Event> checkKeyboardInput(SDL_Event& sdlEvent) {
-    static const std::unordered_map<SDL_Keycode, Event::Keyboard::Key> keymap{
-        { SDLK_q, Event::Keyboard::Key::q },
-        { SDLK_w, Event::Keyboard::Key::w },
-        { SDLK_e, Event::Keyboard::Key::e },
-        { SDLK_r, Event::Keyboard::Key::r },
-        { SDLK_t, Event::Keyboard::Key::t },
-        { SDLK_y, Event::Keyboard::Key::y },
-        { SDLK_u, Event::Keyboard::Key::u },
-        { SDLK_i, Event::Keyboard::Key::i },
-        { SDLK_o, Event::Keyboard::Key::o },
-        { SDLK_p, Event::Keyboard::Key::p },
-        { SDLK_a, Event::Keyboard::Key::a },
-        { SDLK_s, Event::Keyboard::Key::s },
-        { SDLK_d, Event::Keyboard::Key::d },
-        { SDLK_f, Event::Keyboard::Key::f },
-        { SDLK_g, Event::Keyboard::Key::g },
-        { SDLK_h, Event::Keyboard::Key::h },
-        { SDLK_j, Event::Keyboard::Key::j },
-        { SDLK_k, Event::Keyboard::Key::k },
-        { SDLK_l, Event::Keyboard::Key::l },
-        { SDLK_z, Event::Keyboard::Key::z },
-        { SDLK_x, Event::Keyboard::Key::x },
-        { SDLK_c, Event::Keyboard::Key::c },
-        { SDLK_v, Event::Keyboard::Key::v },
-        { SDLK_b, Event::Keyboard::Key::b },
-        { SDLK_n, Event::Keyboard::Key::n },
-        { SDLK_m, Event::Keyboard::Key::m },
-        { SDLK_SPACE, Event::Keyboard::Key::space },
-        { SDLK_RETURN, Event::Keyboard::Key::enter },
-        { SDLK_LCTRL, Event::Keyboard::Key::l_control },
-        { SDLK_LSHIFT, Event::Keyboard::Key::l_shift },
-        { SDLK_ESCAPE, Event::Keyboard::Key::escape },
-        { SDLK_BACKSPACE, Event::Keyboard::Key::backspace },
-
-        // Number keys
-        { SDLK_0, Event::Keyboard::Key::num_0 },
-        { SDLK_1, Event::Keyboard::Key::num_1 },
-        { SDLK_2, Event::Keyboard::Key::num_2 },
-        { SDLK_3, Event::Keyboard::Key::num_3 },
-        { SDLK_4, Event::Keyboard::Key::num_4 },
-        { SDLK_5, Event::Keyboard::Key::num_5 },
-        { SDLK_6, Event::Keyboard::Key::num_6 },
-        { SDLK_7, Event::Keyboard::Key::num_7 },
-        { SDLK_8, Event::Keyboard::Key::num_8 },
-        { SDLK_9, Event::Keyboard::Key::num_9 },
-
-        // Function keys
-        { SDLK_F1, Event::Keyboard::Key::f1 },
-        { SDLK_F2, Event::Keyboard::Key::f2 },
-        { SDLK_F3, Event::Keyboard::Key::f3 },
-        { SDLK_F4, Event::Keyboard::Key::f4 },
-        { SDLK_F5, Event::Keyboard::Key::f5 },
-        { SDLK_F6, Event::Keyboard::Key::f6 },
-        { SDLK_F7, Event::Keyboard::Key::f7 },
-        { SDLK_F8, Event::Keyboard::Key::f8 },
-        { SDLK_F9, Event::Keyboard::Key::f9 },
-        { SDLK_F10, Event::Keyboard::Key::f10 },
-        { SDLK_F11, Event::Keyboard::Key::f11 },
-        { SDLK_F12, Event::Keyboard::Key::f12 },
-
-        // Arrow keys
-        { SDLK_UP, Event::Keyboard::Key::up_arrow },
-        { SDLK_DOWN, Event::Keyboard::Key::down_arrow },
-        { SDLK_LEFT, Event::Keyboard::Key::left_arrow },
-        { SDLK_RIGHT, Event::Keyboard::Key::right_arrow },
-
-        // Miscellaneous keys
-        { SDLK_INSERT, Event::Keyboard::Key::insert },
-        { SDLK_HOME, Event::Keyboard::Key::home },
-        { SDLK_PAGEUP, Event::Keyboard::Key::page_up },
-        { SDLK_DELETE, Event::Keyboard::Key::delete_key },
-        { SDLK_END, Event::Keyboard::Key::end },
-        { SDLK_PAGEDOWN, Event::Keyboard::Key::page_down },
-        { SDLK_CAPSLOCK, Event::Keyboard::Key::caps_lock },
-        { SDLK_SCROLLLOCK, Event::Keyboard::Key::scroll_lock },
-        { SDLK_NUMLOCKCLEAR, Event::Keyboard::Key::num_lock },
-        { SDLK_PRINTSCREEN, Event::Keyboard::Key::print_screen },
-        { SDLK_PAUSE, Event::Keyboard::Key::pause },
-
-        // Numpad keys
-        { SDLK_KP_0, Event::Keyboard::Key::numpad_0 },
-        { SDLK_KP_1, Event::Keyboard::Key::numpad_1 },
-        { SDLK_KP_2, Event::Keyboard::Key::numpad_2 },
-        { SDLK_KP_3, Event::Keyboard::Key::numpad_3 },
-        { SDLK_KP_4, Event::Keyboard::Key::numpad_4 },
-        { SDLK_KP_5, Event::Keyboard::Key::numpad_5 },
-        { SDLK_KP_6, Event::Keyboard::Key::numpad_6 },
-        { SDLK_KP_7, Event::Keyboard::Key::numpad_7 },
-        { SDLK_KP_8, Event::Keyboard::Key::numpad_8 },
-        { SDLK_KP_9, Event::Keyboard::Key::numpad_9 },
-        { SDLK_KP_PERIOD, Event::Keyboard::Key::numpad_decimal },
-        { SDLK_KP_DIVIDE, Event::Keyboard::Key::numpad_divide },
-        { SDLK_KP_MULTIPLY, Event::Keyboard::Key::numpad_multiply },
-        { SDLK_KP_MINUS, Event::Keyboard::Key::numpad_subtract },
-        { SDLK_KP_PLUS, Event::Keyboard::Key::numpad_add },
-        { SDLK_KP_ENTER, Event::Keyboard::Key::numpad_enter },
-
-        { SDLK_UNKNOWN, Event::Keyboard::Key::not_key }
-    };
-
-    if (auto found{ keymap.find(sdlEvent.key.keysym.sym) }; found != keymap.end()) {
+    if (auto key{ key_table::fromKeycode(sdlEvent.key.keysym.sym) };
+        key != Event::Keyboard::Key::not_key) {
         Event event{};
-        event.keyboard.key = found->second;
-        event.mouse.pos.x = sdlEvent.motion.x;
-        event.mouse.pos.y = sdlEvent.motion.y;
+        event.keyboard.key = key;
 
         if (sdlEvent.type == SDL_EVENT_KEY_DOWN)
             event.type = Event::Type::key_down;
@@ -497,43 +264,93 @@ static std::optional<Event> checkMouseInput(SDL_Event& sdlEvent) {
     return std::nullopt;
 }
 
-static std::optional<Event> checkTouchInput(SDL_Event& sdlEvent) {
-    Event event{};
+static void applyEvent(InputState& state, const Event& event) {
+    switch (event.type) {
+    case Event::Type::key_down:
+    case Event::Type::key_up: {
+        const auto index{ static_cast<std::size_t>(event.keyboard.key) };
+        if (index >= InputState::s_keyCount) break;
+
+        const bool isDown{ event.type == Event::Type::key_down };
+        // Key repeat sends key_down for a held key, it isn't a new press.
+        if (isDown && !state.keysDown[index]) state.keysPressed.set(index);
+        if (!isDown && state.keysDown[index]) state.keysReleased.set(index);
+        state.keysDown.set(index, isDown);
+        break;
+    }
 
-    static std::unordered_map<std::int64_t, std::pair<float, float>> fingersMap{};
+    case Event::Type::mouse_down:
+    case Event::Type::mouse_up:
+        if (const auto index{ static_cast<std::size_t>(event.mouse.button) };
+            index < InputState::s_buttonCount)
+            state.buttonsDown.set(index, event.type == Event::Type::mouse_down);
+        state.mousePos = event.mouse.pos;
+        break;
 
-    switch (sdlEvent.type) {
-    case SDL_EVENT_FINGER_DOWN:
-        event.type = Event::Type::touch_down;
-        fingersMap[sdlEvent.tfinger.fingerId].first =
-            sdlEvent.tfinger.x * static_cast<float>(getEngineInstance()->getWindowSize().width);
-        fingersMap[sdlEvent.tfinger.fingerId].second =
-            (1.0f - sdlEvent.tfinger.y) *
-            static_cast<float>(getEngineInstance()->getWindowSize().height);
+    case Event::Type::mouse_motion:
+        state.mousePos = event.mouse.pos;
         break;
-    case SDL_EVENT_FINGER_UP:
-        event.type = Event::Type::touch_up;
+
+    case Event::Type::mouse_wheel:
+        state.wheel.x += event.mouse.wheel.x;
+        state.wheel.y += event.mouse.wheel.y;
         break;
-    case SDL_EVENT_FINGER_MOTION:
-        event.type = Event::Type::touch_motion;
+
+    case Event::Type::touch_down:
+    case Event::Type::touch_motion:
+    case Event::Type::touch_up: {
+        const auto touches{ std::span{ state.touches }.first(state.touchCount) };
+        const auto found{ std::ranges::find(touches, event.touch.id, &InputState::TouchPoint::id) };
+        const InputState::TouchPoint point{ .id = event.touch.id, .pos = event.touch.pos };
+
+        if (event.type == Event::Type::touch_up) {
+            if (found == touches.end()) break;
+            *found = touches.back();
+            --state.touchCount;
+        }
+        else if (found != touches.end())
+            *found = point;
+        else if (state.touchCount < InputState::s_maxTouches)
+            state.touches[state.touchCount++] = point;
         break;
-    default:
-        event.type = Event::Type::not_event;
     }
 
-    event.touch.id = sdlEvent.tfinger.fingerId;
-    event.touch.pos.x =
-        sdlEvent.tfinger.x * static_cast<float>(getEngineInstance()->getWindowSize().width);
-    event.touch.pos.y = (1.0f - sdlEvent.tfinger.y) *
-                        static_cast<float>(getEngineInstance()->getWindowSize().height);
+    case Event::Type::gamepad_added:
+        if (state.gamepadCount < InputState::s_maxGamepads)
+            state.gamepads[state.gamepadCount++] = { .id = event.gamepad.id };
+        break;
 
-    if (event.type == Event::Type::touch_motion) {
-        event.touch.dx = event.touch.pos.x - fingersMap[sdlEvent.tfinger.fingerId].first;
-        event.touch.dy = event.touch.pos.y - fingersMap[sdlEvent.tfinger.fingerId].second;
+    case Event::Type::gamepad_removed:
+    case Event::Type::gamepad_button_down:
+    case Event::Type::gamepad_button_up:
+    case Event::Type::gamepad_axis: {
+        const auto gamepads{ std::span{ state.gamepads }.first(state.gamepadCount) };
+        const auto found{ std::ranges::find(
+            gamepads, event.gamepad.id, &InputState::GamepadState::id) };
+        if (found == gamepads.end()) break;
+
+        if (event.type == Event::Type::gamepad_removed) {
+            std::move(std::next(found), gamepads.end(), found);
+            --state.gamepadCount;
+        }
+        else if (event.type == Event::Type::gamepad_axis) {
+            if (const auto index{ static_cast<std::size_t>(event.gamepad.axis) };
+                index < InputState::s_gamepadAxisCount)
+                found->axes[index] = event.gamepad.value;
+        }
+        else if (const auto index{ static_cast<std::size_t>(event.gamepad.button) };
+                 index < InputState::s_gamepadButtonCount)
+            found->buttonsDown.set(index, event.type == Event::Type::gamepad_button_down);
+        break;
     }
 
-    if (event.type == Event::Type::not_event) return std::nullopt;
-    return event;
+    case Event::Type::turn_off:
+        state.isQuitRequested = true;
+        break;
+
+    default:
+        break;
+    }
 }
 
 static std::string readFile(const fs::path& path) {
@@ -554,6 +371,11 @@ static std::string readFile(const fs::path& path) {
 
 static std::mutex g_audioMutex{};
 
+#ifndef __ANDROID__
+// Values from the command line, they take precedence over the config passed to initialize.
+static json::object g_configOverrides{};
+#endif
+
 class EngineImpl final : public IEngine
 {
 public:
@@ -577,6 +399,34 @@ private:
     std::vector<std::reference_wrapper<Audio>> m_sounds{};
 
     int m_framerate{ 150 };
+    FramePacer m_framePacer{};
+    GpuTimer m_gpuTimer{};
+
+    DisplayMetrics m_displayMetrics{};
+
+    Gamepads m_gamepads{};
+    TouchTracker m_touchTracker{};
+    // Profiler time of the earliest input of the frame, measured until the frame is presented.
+    std::optional<std::int64_t> m_keyboardInputNs{};
+    std::optional<std::int64_t> m_gamepadInputNs{};
+    int m_fixedUpdateRate{};
+    int m_maxFixedUpdateSteps{ 5 };
+
+    bool m_isHeadless{};
+    GLuint m_offscreenFramebuffer{};
+    std::array<GLuint, 2> m_offscreenRenderbuffers{};
+    std::vector<std::uint8_t> m_nullAudioBuffer{};
+    double m_nullAudioFrames{};
+
+    InputScript m_inputScript{};
+    InputRecorder m_inputRecorder{};
+    InputReplay m_inputReplay{};
+    std::optional<std::uint64_t> m_randomSeed{};
+    std::uint64_t m_frameIndex{};
+    std::uint64_t m_maxFrames{};
+
+    InputState m_inputState{};
+    std::vector<Event> m_frameEvents{};
 
 public:
     EngineImpl() = default;
@@ -587,7 +437,8 @@ public:
 
     void uninitialize() override;
 
-    bool readInput(Event& event) override;
+    const InputState& pollInput() override;
+    [[nodiscard]] const InputState& getInputState() const noexcept override;
 
     void swapBuffers() override;
 
@@ -617,10 +468,11 @@ public:
     void render(const Sprite& sprite, const View& view) override;
 
     [[nodiscard]] WindowSize getWindowSize() const noexcept override {
-        int width{};
-        int height{};
-        SDL_GetWindowSize(m_window, &width, &height);
-        return { width, height };
+        return m_displayMetrics.windowSize;
+    }
+
+    [[nodiscard]] const DisplayMetrics& getDisplayMetrics() const noexcept override {
+        return m_displayMetrics;
     }
 
     void setVSync(bool isEnable) override { SDL_GL_SetSwapInterval(isEnable); }
@@ -635,6 +487,39 @@ public:
 
     [[nodiscard]] int getFramerate() const noexcept override { return m_framerate; }
 
+    [[nodiscard]] FrameTimeStats getFrameTimeStats() const noexcept override;
+
+    [[nodiscard]] bool isHeadless() const noexcept override { return m_isHeadless; }
+
+    [[nodiscard]] std::uint64_t getRandomSeed() const noexcept override {
+        return m_randomSeed.value_or(0);
+    }
+
+    std::chrono::nanoseconds resolveFrameTime(std::chrono::nanoseconds measured) override;
+
+    // The name is read back frames later, the game's own may be unloaded by then.
+    void beginGpuScope(const char* name) override {
+        m_gpuTimer.begin(Profiler::getInstance().intern(name));
+    }
+
+    void endGpuScope() override { m_gpuTimer.end(); }
+
+    void setFixedUpdateRate(int updatesPerSecond) override;
+
+    [[nodiscard]] int getFixedUpdateRate() const noexcept override { return m_fixedUpdateRate; }
+
+    void setMaxFixedUpdateSteps(int maxSteps) override;
+
+    [[nodiscard]] int getMaxFixedUpdateSteps() const noexcept override {
+        return m_maxFixedUpdateSteps;
+    }
+
+    void setGamepadDeadzone(float deadzone) override { m_gamepads.setDeadzone(deadzone); }
+
+    [[nodiscard]] float getGamepadDeadzone() const noexcept override {
+        return m_gamepads.getDeadzone();
+    }
+
     [[nodiscard]] ImGuiContext* getImGuiContext() const noexcept override {
         return ImGui::GetCurrentContext();
     }
@@ -650,7 +535,51 @@ public:
     void setFullscreen(bool isFullscreen) override;
 
 private:
-    static void initSDL() {
+    bool nextEvent(Event& event);
+
+    static void markInput(std::optional<std::int64_t>& inputNs, const SDL_Event& sdlEvent) {
+        // SDL timestamps are SDL_GetTicksNS based, the profiler has its own epoch.
+        const auto& profiler{ Profiler::getInstance() };
+        const auto ageNs{ static_cast<std::int64_t>(SDL_GetTicksNS() - sdlEvent.common.timestamp) };
+        const std::int64_t timeNs{ profiler.now() - ageNs };
+        if (!inputNs || timeNs < *inputNs) inputNs = timeNs;
+    }
+
+    // The only place the window size is queried, everything else reads m_displayMetrics.
+    void updateDisplayMetrics() {
+        auto& metrics{ m_displayMetrics };
+        SDL_GetWindowSize(m_window, &metrics.windowSize.width, &metrics.windowSize.height);
+        SDL_GetWindowSizeInPixels(m_window, &metrics.pixelSize.width, &metrics.pixelSize.height);
+
+        const auto width{ static_cast<float>(std::max(metrics.windowSize.width, 1)) };
+        const auto height{ static_cast<float>(std::max(metrics.windowSize.height, 1)) };
+        metrics.displayScale = static_cast<float>(metrics.pixelSize.width) / width;
+        metrics.windowToNdc = { 2.0f / width, 2.0f / height };
+        ++metrics.version;
+
+        m_touchTracker.setWindowSize(static_cast<float>(metrics.windowSize.width),
+                                     static_cast<float>(metrics.windowSize.height));
+    }
+
+    void recordInputLatency() {
+        auto& profiler{ Profiler::getInstance() };
+        const std::int64_t presentNs{ profiler.now() };
+        if (m_keyboardInputNs)
+            profiler.recordZone("input latency: keyboard", *m_keyboardInputNs, presentNs);
+        if (m_gamepadInputNs)
+            profiler.recordZone("input latency: gamepad", *m_gamepadInputNs, presentNs);
+        m_keyboardInputNs.reset();
+        m_gamepadInputNs.reset();
+    }
+
+    static void initSDL(bool isHeadless) {
+        // The offscreen driver creates the GL context over EGL pbuffers/surfaceless, so neither a
+        // display nor a GPU is required (Mesa llvmpipe works).
+        if (isHeadless) {
+            SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+            SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+        }
+
         if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_AUDIO | SDL_INIT_GAMEPAD |
                      SDL_INIT_TIMER) != 0)
             throw std::runtime_error{ "Error : failed call SDL_Init: "s + SDL_GetError() };
@@ -706,6 +635,55 @@ private:
 
         if (gladLoadGLES2Loader(load_gl_pointer) == 0)
             throw std::runtime_error{ "Error : createGLContext : bad gladLoad"s };
+
+        m_gpuTimer.initialize();
+        Profiler::getInstance().setGpuTimingAvailable(m_gpuTimer.isAvailable());
+    }
+
+    void createOffscreenFramebuffer() {
+        const auto [width, height]{ m_displayMetrics.pixelSize };
+
+        glGenFramebuffers(1, &m_offscreenFramebuffer);
+        openGLCheck();
+        glBindFramebuffer(GL_FRAMEBUFFER, m_offscreenFramebuffer);
+        openGLCheck();
+
+        glGenRenderbuffers(static_cast<GLsizei>(m_offscreenRenderbuffers.size()),
+                           m_offscreenRenderbuffers.data());
+        openGLCheck();
+
+        glBindRenderbuffer(GL_RENDERBUFFER, m_offscreenRenderbuffers[0]);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        glFramebufferRenderbuffer(
+            GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_offscreenRenderbuffers[0]);
+        openGLCheck();
+
+        glBindRenderbuffer(GL_RENDERBUFFER, m_offscreenRenderbuffers[1]);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        glFramebufferRenderbuffer(
+            GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_offscreenRenderbuffers[1]);
+        openGLCheck();
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            throw std::runtime_error{
+                "Error : createOffscreenFramebuffer : framebuffer is not complete"s
+            };
+    }
+
+    // Null audio sink: nothing is played, but the mixer consumes the sounds at the device rate
+    // of the simulated frame time, so audio cost and sound positions stay the same.
+    void mixNullAudio() {
+        m_nullAudioFrames += static_cast<double>(m_audioSpec.freq) / m_framerate;
+
+        const int frameSize{ SDL_AUDIO_BITSIZE(m_audioSpec.format) / 8 * m_audioSpec.channels };
+        m_nullAudioBuffer.resize(static_cast<std::size_t>(m_audioSpec.samples * frameSize));
+
+        while (m_nullAudioFrames >= m_audioSpec.samples) {
+            audioCallback(this,
+                          m_nullAudioBuffer.data(),
+                          static_cast<int>(m_nullAudioBuffer.size()));
+            m_nullAudioFrames -= m_audioSpec.samples;
+        }
     }
 
     static void audioCallback(void* engine_ptr, std::uint8_t* stream, int streamSize);
@@ -716,7 +694,20 @@ std::string EngineImpl::initialize(std::string_view config) {
     if (m_window) return "";
 #endif
 
-    initSDL();
+#ifndef __ANDROID__
+    auto jsonValue(json::parse(config));
+    for (const auto& [key, value] : g_configOverrides)
+        jsonValue.as_object()[key] = value;
+
+    m_isHeadless = jsonValue.as_object().contains("headless") &&
+                   jsonValue.as_object().at("headless").as_bool();
+
+    if (jsonValue.as_object().contains("log_level"))
+        Logger::getInstance().setLevel(
+            Logger::strToLevel(jsonValue.as_object().at("log_level").as_string()));
+#endif
+
+    initSDL(m_isHeadless);
 
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS,
                         SDL_GL_CONTEXT_FORWARD_COMPATIBLE_FLAG); // Always required on Mac
@@ -724,8 +715,6 @@ std::string EngineImpl::initialize(std::string_view config) {
 
 #ifndef __ANDROID__
 
-    auto jsonValue(json::parse(config));
-
     auto windowName{ jsonValue.as_object().contains("window_name")
                          ? jsonValue.as_object().at("window_name").as_string()
                          : "SDL + OPENGL"sv };
@@ -749,6 +738,43 @@ std::string EngineImpl::initialize(std::string_view config) {
                         ? jsonValue.as_object().at("window_min_height").as_int64()
                         : 480 };
 
+    if (jsonValue.as_object().contains("fixed_update_rate"))
+        setFixedUpdateRate(
+            static_cast<int>(jsonValue.as_object().at("fixed_update_rate").as_int64()));
+
+    if (jsonValue.as_object().contains("max_fixed_update_steps"))
+        setMaxFixedUpdateSteps(
+            static_cast<int>(jsonValue.as_object().at("max_fixed_update_steps").as_int64()));
+
+    if (jsonValue.as_object().contains("gamepad_deadzone"))
+        setGamepadDeadzone(
+            static_cast<float>(jsonValue.as_object().at("gamepad_deadzone").as_double()));
+
+    if (jsonValue.as_object().contains("input_script"))
+        m_inputScript =
+            InputScript{ jsonValue.as_object().at("input_script").as_string().c_str() };
+
+    m_maxFrames =
+        jsonValue.as_object().contains("max_frames")
+            ? static_cast<std::uint64_t>(jsonValue.as_object().at("max_frames").as_int64())
+            : 0;
+    m_frameIndex = 0;
+
+    if (jsonValue.as_object().contains("record_input") &&
+        jsonValue.as_object().contains("replay_input"))
+        throw std::runtime_error{
+            "Error : EngineImpl::initialize : can't record and replay input at the same time"s
+        };
+
+    if (jsonValue.as_object().contains("replay_input")) {
+        m_inputReplay =
+            InputReplay{ jsonValue.as_object().at("replay_input").as_string().c_str() };
+        m_randomSeed = m_inputReplay.getRandomSeed();
+    }
+    else if (jsonValue.as_object().contains("random_seed"))
+        m_randomSeed =
+            static_cast<std::uint64_t>(jsonValue.as_object().at("random_seed").as_int64());
+
     int flags{};
     flags |= SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN;
     if (isWindowResizable) flags |= SDL_WINDOW_RESIZABLE;
@@ -760,14 +786,30 @@ std::string EngineImpl::initialize(std::string_view config) {
 
     SDL_SetWindowPosition(m_window, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
     SDL_SetWindowMinimumSize(m_window, static_cast<int>(minWidth), static_cast<int>(minHeight));
-    SDL_ShowWindow(m_window);
+    if (!m_isHeadless) SDL_ShowWindow(m_window);
 
 #else
     const SDL_DisplayMode* displayMode{ SDL_GetCurrentDisplayMode(1) };
     m_window = createWindow("android", displayMode->w, displayMode->h, SDL_WINDOW_OPENGL);
 #endif
 
+    updateDisplayMetrics();
+
+    // The seed is chosen once per run, re-initialization after a game reload keeps it.
+    if (!m_randomSeed)
+        m_randomSeed = (static_cast<std::uint64_t>(std::random_device{}()) << 32) ^
+                       static_cast<std::uint64_t>(
+                           std::chrono::steady_clock::now().time_since_epoch().count());
+
+#ifndef __ANDROID__
+    if (jsonValue.as_object().contains("record_input"))
+        m_inputRecorder = InputRecorder{
+            jsonValue.as_object().at("record_input").as_string().c_str(), *m_randomSeed
+        };
+#endif
+
     createGLContext();
+    if (m_isHeadless) createOffscreenFramebuffer();
 
     glEnable(GL_DEPTH_TEST);
     openGLCheck();
@@ -791,34 +833,39 @@ std::string EngineImpl::initialize(std::string_view config) {
     m_audioSpec.callback = audioCallback;
     m_audioSpec.userdata = this;
 
-    std::string defaultAudioDeviceName{};
-    const int numAudioDevices{ SDL_GetNumAudioDevices(SDL_FALSE) };
-    if (numAudioDevices > 0)
-        defaultAudioDeviceName = SDL_GetAudioDeviceName(numAudioDevices - 1, 0);
+    if (!m_isHeadless) {
+        std::string defaultAudioDeviceName{};
+        const int numAudioDevices{ SDL_GetNumAudioDevices(SDL_FALSE) };
+        if (numAudioDevices > 0)
+            defaultAudioDeviceName = SDL_GetAudioDeviceName(numAudioDevices - 1, 0);
 
-    m_currentAudioDeviceName = defaultAudioDeviceName;
+        m_currentAudioDeviceName = defaultAudioDeviceName;
 
-    m_audioDevice = SDL_OpenAudioDevice(defaultAudioDeviceName.c_str(),
-                                        SDL_FALSE,
-                                        &m_audioSpec,
-                                        &m_audioSpec,
-                                        SDL_AUDIO_ALLOW_ANY_CHANGE);
+        m_audioDevice = SDL_OpenAudioDevice(defaultAudioDeviceName.c_str(),
+                                            SDL_FALSE,
+                                            &m_audioSpec,
+                                            &m_audioSpec,
+                                            SDL_AUDIO_ALLOW_ANY_CHANGE);
 
-    if (m_audioDevice == 0)
-        throw std::runtime_error{ "Error : EngineImpl::initialize : failed open audio device: "s +
-                                  SDL_GetError() };
+        if (m_audioDevice == 0)
+            throw std::runtime_error{
+                "Error : EngineImpl::initialize : failed open audio device: "s + SDL_GetError()
+            };
+    }
+    else
+        m_currentAudioDeviceName = "null";
 
-    std::cout << "audio device selected: "sv << defaultAudioDeviceName << '\n'
-              << "freq: "sv << m_audioSpec.freq << '\n'
-              << "format: "sv << m_audioSpec.format << '\n'
-              << "channels: "sv << static_cast<int>(m_audioSpec.channels) << '\n'
-              << "samples: "sv << m_audioSpec.samples << '\n'
-              << std::flush;
+    LOG_INFO("audio device selected",
+             { "device", m_currentAudioDeviceName },
+             { "freq", m_audioSpec.freq },
+             { "format", m_audioSpec.format },
+             { "channels", m_audioSpec.channels },
+             { "samples", m_audioSpec.samples });
 
-    SDL_PlayAudioDevice(m_audioDevice);
+    if (!m_isHeadless) SDL_PlayAudioDevice(m_audioDevice);
 
     recompileShaders();
-    SDL_GL_SetSwapInterval(1);
+    SDL_GL_SetSwapInterval(m_isHeadless ? 0 : 1);
 
     // Setup Dear ImGui context
     IMGUI_CHECKVERSION();
@@ -844,12 +891,25 @@ std::string EngineImpl::initialize(std::string_view config) {
 }
 
 void EngineImpl::uninitialize() {
-    SDL_CloseAudioDevice(m_audioDevice);
+    if (m_audioDevice != 0) SDL_CloseAudioDevice(m_audioDevice);
+    m_audioDevice = 0;
+    m_inputRecorder = {};
+    m_gamepads.closeAll();
     glDeleteVertexArrays(1, &m_verticesArray);
     openGLCheck();
 
+    if (m_offscreenFramebuffer != 0) {
+        glDeleteFramebuffers(1, &m_offscreenFramebuffer);
+        glDeleteRenderbuffers(static_cast<GLsizei>(m_offscreenRenderbuffers.size()),
+                              m_offscreenRenderbuffers.data());
+        openGLCheck();
+        m_offscreenFramebuffer = 0;
+        m_offscreenRenderbuffers = {};
+    }
+
     m_shaderProgram.clear();
     m_shaderProgramWithView.clear();
+    m_gpuTimer.uninitialize();
 
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL3_Shutdown();
@@ -861,9 +921,72 @@ void EngineImpl::uninitialize() {
     SDL_Quit();
 }
 
-bool EngineImpl::readInput(Event& event) {
+const InputState& EngineImpl::pollInput() {
+    m_frameEvents.clear();
+    m_inputState.keysPressed.reset();
+    m_inputState.keysReleased.reset();
+    m_inputState.wheel = {};
+    m_inputState.isQuitRequested = false;
+
+    Event event{};
+    while (nextEvent(event)) {
+        m_inputRecorder.record(m_frameIndex, event);
+        applyEvent(m_inputState, event);
+        m_frameEvents.push_back(event);
+        if (event.type == Event::Type::turn_off) break;
+    }
+
+    m_inputState.events = m_frameEvents;
+    return m_inputState;
+}
+
+const InputState& EngineImpl::getInputState() const noexcept { return m_inputState; }
+
+std::chrono::nanoseconds EngineImpl::resolveFrameTime(std::chrono::nanoseconds measured) {
+    if (m_inputReplay.isOpen())
+        if (auto recorded{ m_inputReplay.getFrameTime(m_frameIndex) }) return *recorded;
+
+    m_inputRecorder.recordFrameTime(m_frameIndex, measured);
+    return measured;
+}
+
+bool EngineImpl::nextEvent(Event& event) {
+    if (m_maxFrames != 0 && m_frameIndex >= m_maxFrames) {
+        event.type = Event::Type::turn_off;
+        return true;
+    }
+
+    // While replaying only the recording drives the game, live input could break determinism.
+    if (m_inputReplay.isOpen()) {
+        if (auto replayed{ m_inputReplay.poll(m_frameIndex) }) {
+            event = *replayed;
+            return true;
+        }
+
+        SDL_Event sdlEvent;
+        while (SDL_PollEvent(&sdlEvent)) {
+            if (sdlEvent.type == SDL_EVENT_QUIT) {
+                event.type = Event::Type::turn_off;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    if (auto scripted{ m_inputScript.poll(m_frameIndex) }) {
+        event = *scripted;
+        return true;
+    }
+
+    if (auto gesture{ m_touchTracker.pollGesture() }) {
+        event = *gesture;
+        return true;
+    }
+
+    // Events that translate to nothing (text input, unknown keys, filtered axis motion...) are
+    // skipped, the events queued behind them still belong to this frame.
     SDL_Event sdlEvent;
-    if (SDL_PollEvent(&sdlEvent)) {
+    while (SDL_PollEvent(&sdlEvent)) {
         ImGui_ImplSDL3_ProcessEvent(&sdlEvent);
 
         switch (sdlEvent.type) {
@@ -874,6 +997,19 @@ bool EngineImpl::readInput(Event& event) {
         case SDL_EVENT_KEY_DOWN:
         case SDL_EVENT_KEY_UP:
             if (auto e{ checkKeyboardInput(sdlEvent) }) {
+                markInput(m_keyboardInputNs, sdlEvent);
+                event = *e;
+                return true;
+            }
+            break;
+
+        case SDL_EVENT_GAMEPAD_ADDED:
+        case SDL_EVENT_GAMEPAD_REMOVED:
+        case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_UP:
+        case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+            if (auto e{ m_gamepads.handle(sdlEvent) }) {
+                markInput(m_gamepadInputNs, sdlEvent);
                 event = *e;
                 return true;
             }
@@ -890,13 +1026,21 @@ bool EngineImpl::readInput(Event& event) {
             break;
 
         case SDL_EVENT_WINDOW_RESIZED:
+            updateDisplayMetrics();
             event.type = Event::Type::window_resized;
+            event.window.width = sdlEvent.window.data1;
+            event.window.height = sdlEvent.window.data2;
             return true;
 
+        case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+        case SDL_EVENT_WINDOW_DISPLAY_CHANGED:
+            updateDisplayMetrics();
+            break;
+
         case SDL_EVENT_FINGER_DOWN:
         case SDL_EVENT_FINGER_UP:
         case SDL_EVENT_FINGER_MOTION:
-            if (auto e{ checkTouchInput(sdlEvent) }) {
+            if (auto e{ m_touchTracker.handle(sdlEvent) }) {
                 event = *e;
                 return true;
             }
@@ -908,15 +1052,35 @@ bool EngineImpl::readInput(Event& event) {
 }
 
 void EngineImpl::swapBuffers() {
+    ENGINE_PROFILE_SCOPE("swapBuffers");
     ImGui::Render();
+    m_gpuTimer.begin("ImGui");
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    m_gpuTimer.end();
 
-    int width{}, height{};
-    SDL_GetWindowSizeInPixels(m_window, &width, &height);
-    glViewport(0, 0, width, height);
+    glViewport(0, 0, m_displayMetrics.pixelSize.width, m_displayMetrics.pixelSize.height);
     openGLCheck();
 
-    SDL_GL_SwapWindow(m_window);
+    if (!m_isHeadless)
+        SDL_GL_SwapWindow(m_window);
+    else {
+        // Nothing is presented, finish the frame so GPU work can't pile up between frames.
+        glFinish();
+        mixNullAudio();
+    }
+    recordInputLatency();
+    ++m_frameIndex;
+
+    m_gpuTimer.newFrame();
+    for (const auto& result : m_gpuTimer.getResults())
+        Profiler::getInstance().recordGpuZone(result.name,
+                                              static_cast<std::int64_t>(result.durationNs));
+
+    // With vsync the swap itself waits for the display, 300+ fps is treated as unlimited.
+    {
+        ENGINE_PROFILE_SCOPE("FramePacer::wait");
+        m_framePacer.wait(!m_isHeadless && !getVSync() && m_framerate < 300 ? m_framerate : 0);
+    }
 
     glClearColor(0.0f, 0.0f, 0.f, 1.f);
     openGLCheck();
@@ -925,6 +1089,15 @@ void EngineImpl::swapBuffers() {
     openGLCheck();
 }
 
+IEngine::FrameTimeStats EngineImpl::getFrameTimeStats() const noexcept {
+    const auto& stats{ m_framePacer.getStats() };
+    return { .p50 = stats.p50,
+             .p99 = stats.p99,
+             .max = stats.max,
+             .historyMs = m_framePacer.getHistory(),
+             .historyOffset = m_framePacer.getHistoryOffset() };
+}
+
 void EngineImpl::recompileShaders() {
 #ifndef __ANDROID__
     m_shaderProgram.recompileShaders(
@@ -1080,6 +1253,7 @@ void EngineImpl::render(const Sprite& sprite, const View& view) {
 }
 
 void EngineImpl::audioCallback(void* engine_ptr, std::uint8_t* stream, int streamSize) {
+    ENGINE_PROFILE_SCOPE("audioCallback");
     std::lock_guard lock{ g_audioMutex };
     auto engine{ static_cast<EngineImpl*>(engine_ptr) };
 
@@ -1128,6 +1302,8 @@ const std::string& EngineImpl::getCurrentAudioDeviceName() const noexcept {
 }
 
 void EngineImpl::setAudioDevice(std::string_view audioDeviceName) {
+    if (m_isHeadless) return;
+
     SDL_CloseAudioDevice(m_audioDevice);
     m_audioDevice =
         SDL_OpenAudioDevice(audioDeviceName.data(), SDL_FALSE, &m_audioSpec, &m_audioSpec, 0);
@@ -1136,12 +1312,12 @@ void EngineImpl::setAudioDevice(std::string_view audioDeviceName) {
         throw std::runtime_error{ "Error : setAudioDevice : can't open audio device"s };
     m_currentAudioDeviceName = audioDeviceName;
 
-    std::cout << "audio device selected: "sv << m_currentAudioDeviceName << '\n'
-              << "freq: "sv << m_audioSpec.freq << '\n'
-              << "format: "sv << m_audioSpec.format << '\n'
-              << "channels: "sv << static_cast<int>(m_audioSpec.channels) << '\n'
-              << "samples: "sv << m_audioSpec.samples << '\n'
-              << std::flush;
+    LOG_INFO("audio device selected",
+             { "device", m_currentAudioDeviceName },
+             { "freq", m_audioSpec.freq },
+             { "format", m_audioSpec.format },
+             { "channels", m_audioSpec.channels },
+             { "samples", m_audioSpec.samples });
 
     std::lock_guard lock{ g_audioMutex };
     for (Audio& sound : m_sounds) {
@@ -1171,6 +1347,18 @@ void EngineImpl::setAudioDevice(std::string_view audioDeviceName) {
     SDL_PlayAudioDevice(m_audioDevice);
 }
 
+void EngineImpl::setFixedUpdateRate(int updatesPerSecond) {
+    if (updatesPerSecond < 0)
+        throw std::runtime_error{ "Error : setFixedUpdateRate : rate should be >= 0"s };
+    m_fixedUpdateRate = updatesPerSecond;
+}
+
+void EngineImpl::setMaxFixedUpdateSteps(int maxSteps) {
+    if (maxSteps < 1)
+        throw std::runtime_error{ "Error : setMaxFixedUpdateSteps : max steps should be >= 1"s };
+    m_maxFixedUpdateSteps = maxSteps;
+}
+
 int EngineImpl::getAudioVolume() const noexcept { return m_audioVolume; }
 
 void EngineImpl::setAudioVolume(int audioVolume) {
@@ -1264,6 +1452,29 @@ void Audio::play(bool isLooped) {
     m_isLooped = isLooped;
 }
 
+// Runs the simulation part of the frame and returns interpolation factor for the render.
+static float simulateFrame(IEngine& engine,
+                           IGame& game,
+                           FixedTimestep& fixedTimestep,
+                           std::chrono::nanoseconds frameTime) {
+    frameTime = engine.resolveFrameTime(frameTime);
+    fixedTimestep.setUpdateRate(engine.getFixedUpdateRate());
+    fixedTimestep.setMaxSteps(engine.getMaxFixedUpdateSteps());
+
+    ENGINE_PROFILE_SCOPE("fixedUpdate");
+    if (!fixedTimestep.isEnabled()) {
+        game.fixedUpdate(std::chrono::duration_cast<std::chrono::microseconds>(frameTime));
+        return 1.0f;
+    }
+
+    const auto step{ std::chrono::duration_cast<std::chrono::microseconds>(
+        fixedTimestep.getStep()) };
+    for (int steps{ fixedTimestep.advance(frameTime) }; steps > 0; --steps)
+        game.fixedUpdate(step);
+
+    return fixedTimestep.getAlpha();
+}
+
 #ifndef __ANDROID__
 static std::unique_ptr<IGame, std::function<void(IGame* game)>>
 reloadGame(std::unique_ptr<IGame, std::function<void(IGame* game)>> oldGame,
@@ -1281,7 +1492,7 @@ reloadGame(std::unique_ptr<IGame, std::function<void(IGame* game)>> oldGame,
 
     auto gameHandle{ SDL_LoadObject(tempLibraryName.data()) };
     if (gameHandle == nullptr) {
-        std::cerr << "Failed SDL_LoadObject\n"sv;
+        LOG_ERROR("failed to load game library", { "error", SDL_GetError() });
         return nullptr;
     }
 
@@ -1289,7 +1500,7 @@ reloadGame(std::unique_ptr<IGame, std::function<void(IGame* game)>> oldGame,
 
     auto createGameFuncPtr{ SDL_LoadFunction(gameHandle, "createGame") };
     if (createGameFuncPtr == nullptr) {
-        std::cerr << "Failed : SDL_LoadFunction : createGame\n"sv;
+        LOG_ERROR("failed to load game function", { "function", "createGame" });
         return nullptr;
     }
 
@@ -1298,7 +1509,7 @@ reloadGame(std::unique_ptr<IGame, std::function<void(IGame* game)>> oldGame,
 
     auto destroyGameFuncPtr{ SDL_LoadFunction(gameHandle, "destroyGame") };
     if (destroyGameFuncPtr == nullptr) {
-        std::cerr << "Failed : SDL_LoadFunction : destroyGame\n"sv;
+        LOG_ERROR("failed to load game function", { "function", "destroyGame" });
         return nullptr;
     }
 
@@ -1313,6 +1524,11 @@ reloadGame(std::unique_ptr<IGame, std::function<void(IGame* game)>> oldGame,
 struct Args
 {
     std::string configFilePath{};
+    std::string inputScriptPath{};
+    std::string recordInputPath{};
+    std::string replayInputPath{};
+    std::int64_t maxFrames{};
+    bool isHeadless{};
 };
 
 std::optional<Args> parseCommandLine(int argc, const char* argv[]) {
@@ -1323,13 +1539,37 @@ std::optional<Args> parseCommandLine(int argc, const char* argv[]) {
     description.add_options()("help,h", "produce help message") //
         ("config-file,c",
          po::value(&args.configFilePath)->value_name("file"),
-         "set config file path");
+         "set config file path") //
+        ("headless",
+         po::bool_switch(&args.isHeadless),
+         "render offscreen with null audio and simulated frame time") //
+        ("input-script",
+         po::value(&args.inputScriptPath)->value_name("file"),
+         "feed input events from the script") //
+        ("frames", po::value(&args.maxFrames)->value_name("count"), "exit after count frames") //
+        ("record-input",
+         po::value(&args.recordInputPath)->value_name("file"),
+         "record input events with the random seed") //
+        ("replay-input",
+         po::value(&args.replayInputPath)->value_name("file"),
+         "replay recorded input events with the recorded random seed") //
+        ("seed", po::value<std::uint64_t>()->value_name("number"), "set random seed");
 
     po::variables_map vm{};
     po::store(po::parse_command_line(argc, argv, description), vm);
     po::notify(vm);
 
     if (!vm.contains("config-file")) throw std::runtime_error{ "Config file not been specified"s };
+    if (args.maxFrames < 0) throw std::runtime_error{ "Frames count should be >= 0"s };
+
+    if (args.isHeadless) g_configOverrides["headless"] = true;
+    if (!args.inputScriptPath.empty()) g_configOverrides["input_script"] = args.inputScriptPath;
+    if (args.maxFrames > 0) g_configOverrides["max_frames"] = args.maxFrames;
+    if (!args.recordInputPath.empty()) g_configOverrides["record_input"] = args.recordInputPath;
+    if (!args.replayInputPath.empty()) g_configOverrides["replay_input"] = args.replayInputPath;
+    if (vm.contains("seed"))
+        g_configOverrides["random_seed"] =
+            static_cast<std::int64_t>(vm["seed"].as<std::uint64_t>());
 
     return args;
 }
@@ -1377,14 +1617,14 @@ int main(int argc, const char* argv[]) {
             auto& engine{ getEngineInstance() };
             auto answer{ engine->initialize("{}") };
             if (!answer.empty()) { return EXIT_FAILURE; }
-            std::cout << "start app"sv << std::endl;
+            LOG_INFO("start app");
 
             std::string_view tempLibraryName{ "./temp.dll" };
             void* gameLibraryHandle{};
             std::unique_ptr<IGame, std::function<void(IGame * game)>> game;
 
             HotReloadProvider::getInstance().addToCheck("game", [&]() {
-                std::cout << "changing game\n"sv;
+                LOG_INFO("hot reload", { "target", "game" });
                 game = reloadGame(std::move(game),
                                   HotReloadProvider::getInstance().getPath("game"),
                                   tempLibraryName,
@@ -1395,52 +1635,68 @@ int main(int argc, const char* argv[]) {
             });
 
             HotReloadProvider::getInstance().addToCheck("vertex_shader_with_view", [&]() {
-                std::cout << "recompile shaders\n"sv;
+                LOG_INFO("hot reload", { "target", "vertex_shader_with_view" });
                 engine->recompileShaders();
             });
 
             HotReloadProvider::getInstance().addToCheck("vertex_shader_without_view", [&]() {
-                std::cout << "recompile shaders\n"sv;
+                LOG_INFO("hot reload", { "target", "vertex_shader_without_view" });
                 engine->recompileShaders();
             });
 
             HotReloadProvider::getInstance().addToCheck("fragment_shader", [&]() {
-                std::cout << "recompile shaders\n"sv;
+                LOG_INFO("hot reload", { "target", "fragment_shader" });
                 engine->recompileShaders();
             });
 
             HotReloadProvider::getInstance().check();
 
+            FixedTimestep fixedTimestep{};
+            auto lastFrameTime{ std::chrono::steady_clock::now() };
+
             bool isEnd{};
             while (!isEnd) {
-                std::uint64_t frameStart{ SDL_GetTicks() };
+                // Headless runs simulate the frame time so they are reproducible.
+                const auto now{ std::chrono::steady_clock::now() };
+                const auto frameTime{ engine->isHeadless()
+                                          ? std::chrono::nanoseconds{ 1s } / engine->getFramerate()
+                                          : std::chrono::nanoseconds{ now - lastFrameTime } };
+                lastFrameTime = now;
+
+                Profiler::getInstance().newFrame();
+                ENGINE_PROFILE_SCOPE("frame");
+
                 HotReloadProvider::getInstance().check();
-                Event event{};
-                while (engine->readInput(event)) {
-                    std::cout << event << '\n';
-                    if (event.type == Event::Type::turn_off) {
-                        std::cout << "exiting"sv << std::endl;
+                {
+                    ENGINE_PROFILE_SCOPE("pollInput");
+                    const auto& input{ engine->pollInput() };
+                    for (const auto& event : input.events)
+                        logEvent(event);
+
+                    if (input.isQuitRequested) {
+                        LOG_INFO("exiting");
                         isEnd = true;
-                        break;
                     }
-
-                    game->onEvent(event);
+                    else
+                        game->onInput(input);
                 }
 
                 ImGui_ImplSDL3_NewFrame();
                 ImGui_ImplOpenGL3_NewFrame();
                 ImGui::NewFrame();
 
-                game->update();
-                game->render();
+                const float alpha{ simulateFrame(*engine, *game, fixedTimestep, frameTime) };
+                {
+                    ENGINE_PROFILE_SCOPE("update");
+                    game->update();
+                }
+                {
+                    ENGINE_PROFILE_SCOPE("render");
+                    game->render(alpha);
+                }
 
+                Profiler::getInstance().drawImGui();
                 engine->swapBuffers();
-
-                if (!engine->getVSync() && engine->getFramerate() < 300) {
-                    int frameDelay = 1000 / engine->getFramerate();
-                    std::uint64_t frameTime{ SDL_GetTicks() - frameStart };
-                    if (frameTime < frameDelay) SDL_Delay(frameDelay - frameTime);
-                }
             }
 
             engine->uninitialize();
@@ -1448,10 +1704,12 @@ int main(int argc, const char* argv[]) {
         }
     }
     catch (const std::exception& e) {
-        std::cerr << e.what() << '\n';
+        LOG_ERROR(e.what());
+        Logger::getInstance().flush();
     }
     catch (...) {
-        std::cerr << "Unknown error"sv << '\n';
+        LOG_ERROR("unknown error");
+        Logger::getInstance().flush();
     }
 
     return EXIT_FAILURE;
@@ -1492,45 +1750,60 @@ int main(int argc, char* argv[]) {
 
         game->initialize();
 
+        FixedTimestep fixedTimestep{};
+        auto lastFrameTime{ std::chrono::steady_clock::now() };
+
         bool isEnd{};
         while (!isEnd) {
-            std::uint64_t frameStart{ SDL_GetTicks() };
-            Event event{};
-            while (engine->readInput(event)) {
-                std::cout << event << '\n';
-                if (event.type == Event::Type::turn_off) {
-                    std::cout << "exiting"sv << std::endl;
+            const auto now{ std::chrono::steady_clock::now() };
+            const auto frameTime{ now - lastFrameTime };
+            lastFrameTime = now;
+
+            Profiler::getInstance().newFrame();
+            ENGINE_PROFILE_SCOPE("frame");
+
+            {
+                ENGINE_PROFILE_SCOPE("pollInput");
+                const auto& input{ engine->pollInput() };
+                for (const auto& event : input.events)
+                    logEvent(event);
+
+                if (input.isQuitRequested) {
+                    LOG_INFO("exiting");
                     isEnd = true;
-                    break;
                 }
-
-                game->onEvent(event);
+                else
+                    game->onInput(input);
             }
 
             ImGui_ImplSDL3_NewFrame();
             ImGui_ImplOpenGL3_NewFrame();
             ImGui::NewFrame();
 
-            game->update();
-            game->render();
+            const float alpha{ simulateFrame(*engine, *game, fixedTimestep, frameTime) };
+            {
+                ENGINE_PROFILE_SCOPE("update");
+                game->update();
+            }
+            {
+                ENGINE_PROFILE_SCOPE("render");
+                game->render(alpha);
+            }
 
+            Profiler::getInstance().drawImGui();
             engine->swapBuffers();
-
-            if (!engine->getVSync() && engine->getFramerate() < 300) {
-                int frameDelay = 1000 / engine->getFramerate();
-                std::uint64_t frameTime{ SDL_GetTicks() - frameStart };
-                if (frameTime < frameDelay) SDL_Delay(frameDelay - frameTime);
-            }
         }
 
         engine->uninitialize();
         return EXIT_SUCCESS;
     }
     catch (const std::exception& e) {
-        std::cerr << e.what() << '\n';
+        LOG_ERROR(e.what());
+        Logger::getInstance().flush();
     }
     catch (...) {
-        std::cerr << "Unknown error"sv << '\n';
+        LOG_ERROR("unknown error");
+        Logger::getInstance().flush();
     }
 
     return EXIT_FAILURE;
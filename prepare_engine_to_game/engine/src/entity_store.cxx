@@ -0,0 +1,257 @@
+#include "entity_store.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include "quad_transform.hxx"
+
+using namespace std::literals;
+
+static constexpr std::uint32_t s_noIndex{ std::numeric_limits<std::uint32_t>::max() };
+
+EntityStore::RegionId EntityStore::addRegion(const Region& region) {
+    if (m_regionSizes.size() > std::numeric_limits<RegionId>::max())
+        throw std::runtime_error{ "Error : addRegion : too many regions"s };
+
+    m_regionSizes.push_back(region.size);
+    m_regionUvs.push_back(region.uv);
+    ++m_version;
+    return static_cast<RegionId>(m_regionSizes.size() - 1);
+}
+
+EntityStore::Region EntityStore::getRegion(RegionId id) const {
+    if (id >= m_regionSizes.size())
+        throw std::runtime_error{ "Error : getRegion : bad region id"s };
+    return { .size = m_regionSizes[id], .uv = m_regionUvs[id] };
+}
+
+EntityStore::Entity EntityStore::create(Position position, RegionId region) {
+    if (region >= m_regionSizes.size())
+        throw std::runtime_error{ "Error : create : bad region id"s };
+
+    std::uint32_t slot{};
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else {
+        if (m_denseIndices.size() == s_indexMask)
+            throw std::runtime_error{ "Error : create : too many entities"s };
+        slot = static_cast<std::uint32_t>(m_denseIndices.size());
+        m_denseIndices.push_back(s_noIndex);
+        m_generations.push_back(0);
+    }
+
+    const Entity entity{ static_cast<Entity>(m_generations[slot]) << s_indexBits | slot };
+    m_denseIndices[slot] = static_cast<std::uint32_t>(m_entities.size());
+    m_positionX.push_back(position.x);
+    m_positionY.push_back(position.y);
+    m_velocityX.push_back(0.0f);
+    m_velocityY.push_back(0.0f);
+    m_rotationSin.push_back(0.0f);
+    m_rotationCos.push_back(1.0f);
+    m_halfWidth.push_back(m_regionSizes[region].width / 2.0f);
+    m_halfHeight.push_back(m_regionSizes[region].height / 2.0f);
+    m_regionIds.push_back(region);
+    m_entities.push_back(entity);
+
+    m_boundsMinX.push_back(0.0f);
+    m_boundsMinY.push_back(0.0f);
+    m_boundsMaxX.push_back(0.0f);
+    m_boundsMaxY.push_back(0.0f);
+
+    ++m_version;
+    return entity;
+}
+
+void EntityStore::destroy(Entity entity) {
+    const auto index{ getDenseIndex(entity) };
+    const auto last{ m_entities.size() - 1 };
+
+    const auto moveLast{ [index, last](auto& components) {
+        components[index] = components[last];
+        components.pop_back();
+    } };
+    moveLast(m_positionX);
+    moveLast(m_positionY);
+    moveLast(m_velocityX);
+    moveLast(m_velocityY);
+    moveLast(m_rotationSin);
+    moveLast(m_rotationCos);
+    moveLast(m_halfWidth);
+    moveLast(m_halfHeight);
+    moveLast(m_regionIds);
+    moveLast(m_entities);
+
+    // The bounds are recomputed anyway, the version changes.
+    m_boundsMinX.pop_back();
+    m_boundsMinY.pop_back();
+    m_boundsMaxX.pop_back();
+    m_boundsMaxY.pop_back();
+
+    const auto slot{ entity & s_indexMask };
+    if (index != last) m_denseIndices[m_entities[index] & s_indexMask] = index;
+    m_denseIndices[slot] = s_noIndex;
+    ++m_generations[slot];
+    m_freeSlots.push_back(slot);
+    ++m_version;
+}
+
+void EntityStore::clear() {
+    for (const auto entity : m_entities)
+        ++m_generations[entity & s_indexMask];
+    std::ranges::fill(m_denseIndices, s_noIndex);
+    m_freeSlots.resize(m_denseIndices.size());
+    std::iota(m_freeSlots.rbegin(), m_freeSlots.rend(), std::uint32_t{});
+
+    m_positionX.clear();
+    m_positionY.clear();
+    m_velocityX.clear();
+    m_velocityY.clear();
+    m_rotationSin.clear();
+    m_rotationCos.clear();
+    m_halfWidth.clear();
+    m_halfHeight.clear();
+    m_regionIds.clear();
+    m_entities.clear();
+    m_boundsMinX.clear();
+    m_boundsMinY.clear();
+    m_boundsMaxX.clear();
+    m_boundsMaxY.clear();
+    ++m_version;
+}
+
+bool EntityStore::isAlive(Entity entity) const noexcept {
+    const auto slot{ entity & s_indexMask };
+    return slot < m_denseIndices.size() && m_denseIndices[slot] != s_noIndex &&
+           m_generations[slot] == entity >> s_indexBits;
+}
+
+std::size_t EntityStore::size() const noexcept { return m_entities.size(); }
+
+bool EntityStore::empty() const noexcept { return m_entities.empty(); }
+
+void EntityStore::setPosition(Entity entity, Position position) {
+    const auto index{ getDenseIndex(entity) };
+    m_positionX[index] = position.x;
+    m_positionY[index] = position.y;
+    ++m_version;
+}
+
+Position EntityStore::getPosition(Entity entity) const {
+    const auto index{ getDenseIndex(entity) };
+    return { m_positionX[index], m_positionY[index] };
+}
+
+void EntityStore::setVelocity(Entity entity, Position velocity) {
+    const auto index{ getDenseIndex(entity) };
+    m_velocityX[index] = velocity.x;
+    m_velocityY[index] = velocity.y;
+}
+
+void EntityStore::setRotation(Entity entity, float radians) {
+    const auto index{ getDenseIndex(entity) };
+    m_rotationSin[index] = std::sin(radians);
+    m_rotationCos[index] = std::cos(radians);
+    ++m_version;
+}
+
+void EntityStore::setScale(Entity entity, Scale scale) {
+    const auto index{ getDenseIndex(entity) };
+    const auto& size{ m_regionSizes[m_regionIds[index]] };
+    m_halfWidth[index] = size.width * scale.x / 2.0f;
+    m_halfHeight[index] = size.height * scale.y / 2.0f;
+    ++m_version;
+}
+
+std::uint64_t EntityStore::getVersion() const noexcept { return m_version; }
+
+void EntityStore::integrate(float dt) noexcept {
+    const auto count{ m_entities.size() };
+    float* positionX{ m_positionX.data() };
+    float* positionY{ m_positionY.data() };
+    const float* velocityX{ m_velocityX.data() };
+    const float* velocityY{ m_velocityY.data() };
+
+    bool isMoved{};
+    for (std::size_t i{}; i < count; ++i) {
+        positionX[i] += velocityX[i] * dt;
+        positionY[i] += velocityY[i] * dt;
+        isMoved |= velocityX[i] != 0.0f || velocityY[i] != 0.0f;
+    }
+    if (isMoved) ++m_version;
+}
+
+std::optional<EntityStore::Entity>
+EntityStore::findOverlap(const Rectangle& rectangle) const noexcept {
+    if (m_boundsVersion != m_version) updateBounds();
+
+    const float left{ rectangle.xy.x };
+    const float right{ rectangle.xy.x + rectangle.wh.width };
+    const float bottom{ rectangle.xy.y };
+    const float top{ rectangle.xy.y + rectangle.wh.height };
+
+    for (std::size_t i{}; i < m_entities.size(); ++i)
+        if (m_boundsMinX[i] <= right && left <= m_boundsMaxX[i] && m_boundsMinY[i] <= top &&
+            bottom <= m_boundsMaxY[i])
+            return m_entities[i];
+    return std::nullopt;
+}
+
+void EntityStore::buildQuads(glm::vec2 worldToNdc, std::span<Vertex2> vertices) const {
+    if (vertices.size() != m_entities.size() * 4)
+        throw std::runtime_error{ "Error : buildQuads : bad vertex count"s };
+
+    transformQuads({ .positionX = m_positionX.data(),
+                     .positionY = m_positionY.data(),
+                     .rotationSin = m_rotationSin.data(),
+                     .rotationCos = m_rotationCos.data(),
+                     .halfWidth = m_halfWidth.data(),
+                     .halfHeight = m_halfHeight.data(),
+                     .count = m_entities.size() },
+                   { .uvs = m_regionUvs.data(), .uvIndices = m_regionIds.data() },
+                   worldToNdc,
+                   vertices.data(),
+                   { .minX = m_boundsMinX.data(),
+                     .minY = m_boundsMinY.data(),
+                     .maxX = m_boundsMaxX.data(),
+                     .maxY = m_boundsMaxY.data() });
+    m_boundsVersion = m_version;
+}
+
+void EntityStore::buildQuadIndices(std::size_t quadCount, std::vector<std::uint32_t>& indices) {
+    indices.resize(quadCount * 6);
+    for (std::uint32_t quad{}; quad < quadCount; ++quad) {
+        const auto base{ quad * 4 };
+        auto* index{ indices.data() + quad * 6 };
+        index[0] = base;
+        index[1] = base + 1;
+        index[2] = base + 2;
+        index[3] = base;
+        index[4] = base + 2;
+        index[5] = base + 3;
+    }
+}
+
+std::uint32_t EntityStore::getDenseIndex(Entity entity) const {
+    if (!isAlive(entity)) throw std::runtime_error{ "Error : EntityStore : dead entity"s };
+    return m_denseIndices[entity & s_indexMask];
+}
+
+void EntityStore::updateBounds() const noexcept {
+    computeQuadBounds({ .positionX = m_positionX.data(),
+                        .positionY = m_positionY.data(),
+                        .rotationSin = m_rotationSin.data(),
+                        .rotationCos = m_rotationCos.data(),
+                        .halfWidth = m_halfWidth.data(),
+                        .halfHeight = m_halfHeight.data(),
+                        .count = m_entities.size() },
+                      { .minX = m_boundsMinX.data(),
+                        .minY = m_boundsMinY.data(),
+                        .maxX = m_boundsMaxX.data(),
+                        .maxY = m_boundsMaxY.data() });
+    m_boundsVersion = m_version;
+}
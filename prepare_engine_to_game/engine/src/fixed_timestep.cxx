@@ -0,0 +1,47 @@
+#include "fixed_timestep.hxx"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals;
+
+void FixedTimestep::setUpdateRate(int updatesPerSecond) {
+    if (updatesPerSecond < 0)
+        throw std::runtime_error{ "Error : FixedTimestep::setUpdateRate : rate should be >= 0"s };
+
+    if (updatesPerSecond == m_updateRate) return;
+
+    m_updateRate = updatesPerSecond;
+    m_step = m_updateRate > 0 ? std::chrono::nanoseconds{ 1s } / m_updateRate
+                              : std::chrono::nanoseconds{};
+    m_accumulator = {};
+}
+
+void FixedTimestep::setMaxSteps(int maxSteps) {
+    if (maxSteps < 1)
+        throw std::runtime_error{ "Error : FixedTimestep::setMaxSteps : max steps should be >= 1"s };
+    m_maxSteps = maxSteps;
+}
+
+bool FixedTimestep::isEnabled() const noexcept { return m_updateRate > 0; }
+
+std::chrono::nanoseconds FixedTimestep::getStep() const noexcept { return m_step; }
+
+int FixedTimestep::advance(std::chrono::nanoseconds frameTime) {
+    if (!isEnabled()) return 0;
+
+    m_accumulator += std::clamp(frameTime, std::chrono::nanoseconds{}, m_step * m_maxSteps);
+
+    auto steps{ static_cast<int>(std::min<std::int64_t>(m_accumulator / m_step, m_maxSteps)) };
+    m_accumulator -= m_step * steps;
+    if (m_accumulator >= m_step) m_accumulator %= m_step;
+
+    return steps;
+}
+
+float FixedTimestep::getAlpha() const noexcept {
+    if (!isEnabled()) return 1.0f;
+    return std::chrono::duration<float>{ m_accumulator } / std::chrono::duration<float>{ m_step };
+}
@@ -0,0 +1,32 @@
+#ifndef ENGINE_PREPARE_TO_GAME_FIXED_TIMESTEP_HXX
+#define ENGINE_PREPARE_TO_GAME_FIXED_TIMESTEP_HXX
+
+#include <chrono>
+
+// Accumulates real frame time and converts it into a whole number of fixed simulation steps.
+// The remainder is exposed as an interpolation factor for rendering between two steps.
+class FixedTimestep final
+{
+private:
+    std::chrono::nanoseconds m_step{};
+    std::chrono::nanoseconds m_accumulator{};
+    int m_updateRate{};
+    int m_maxSteps{ 5 };
+
+public:
+    // 0 disables the fixed-timestep mode.
+    void setUpdateRate(int updatesPerSecond);
+    void setMaxSteps(int maxSteps);
+
+    [[nodiscard]] bool isEnabled() const noexcept;
+    [[nodiscard]] std::chrono::nanoseconds getStep() const noexcept;
+
+    // Returns how many fixed steps should be simulated for this frame. Never more than max steps,
+    // the time that does not fit is dropped so a hitch can't snowball into the next frames.
+    int advance(std::chrono::nanoseconds frameTime);
+
+    // Fraction of a step left in the accumulator, in range [0, 1).
+    [[nodiscard]] float getAlpha() const noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_FIXED_TIMESTEP_HXX
@@ -0,0 +1,96 @@
+#include "frame_pacer.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace std::literals;
+
+void FramePacer::wait(int framerate) {
+    if (framerate > 0) {
+        const auto period{ std::chrono::nanoseconds{ 1s } / framerate };
+        m_deadline += period;
+
+        // Fell behind by more than a frame (hitch, breakpoint, minimized window) - don't try to
+        // catch up with a burst of short frames, start counting from now.
+        const auto now{ Clock::now() };
+        if (now - m_deadline > period) m_deadline = now;
+
+        sleepUntil(m_deadline);
+    }
+
+    const auto frameEnd{ Clock::now() };
+    if (framerate <= 0) m_deadline = frameEnd;
+
+    record(frameEnd - m_lastFrameEnd);
+    m_lastFrameEnd = frameEnd;
+}
+
+void FramePacer::sleepUntil(Clock::time_point deadline) {
+    // Coarse phase: 1 ms sleeps while there is more time left than a sleep may oversleep by.
+    while (std::chrono::duration<double>{ deadline - Clock::now() }.count() > m_spinThreshold) {
+        const auto start{ Clock::now() };
+        std::this_thread::sleep_for(1ms);
+        const double observed{ std::chrono::duration<double>{ Clock::now() - start }.count() };
+
+        ++m_sleepCount;
+        const double delta{ observed - m_sleepMean };
+        m_sleepMean += delta / static_cast<double>(m_sleepCount);
+        m_sleepM2 += delta * (observed - m_sleepMean);
+        const double stddev{ std::sqrt(m_sleepM2 / static_cast<double>(m_sleepCount - 1)) };
+        m_spinThreshold = m_sleepMean + stddev;
+
+        // Keep the estimate adaptive, old samples should not dominate forever.
+        if (m_sleepCount > 1000) {
+            m_sleepCount = 1;
+            m_sleepMean = observed;
+            m_sleepM2 = 0;
+        }
+    }
+
+    // Fine phase: spin, yielding so a second hardware thread is not stolen.
+    while (Clock::now() < deadline)
+        std::this_thread::yield();
+}
+
+std::size_t FramePacer::toBucket(std::int64_t frameTimeNs) noexcept {
+    const auto bucket{ frameTimeNs / std::chrono::nanoseconds{ s_bucketWidth }.count() };
+    return static_cast<std::size_t>(
+        std::clamp<std::int64_t>(bucket, 0, static_cast<std::int64_t>(s_bucketCount) - 1));
+}
+
+void FramePacer::record(std::chrono::nanoseconds frameTime) {
+    const std::int64_t frameTimeNs{ frameTime.count() };
+
+    if (m_windowFill == s_windowSize)
+        --m_buckets[toBucket(m_window[m_windowHead])];
+    else
+        ++m_windowFill;
+
+    m_window[m_windowHead] = frameTimeNs;
+    m_windowHead = (m_windowHead + 1) % s_windowSize;
+    ++m_buckets[toBucket(frameTimeNs)];
+
+    m_historyMs[m_historyHead] = std::chrono::duration<float, std::milli>{ frameTime }.count();
+    m_historyHead = (m_historyHead + 1) % s_historySize;
+
+    updateStats();
+}
+
+void FramePacer::updateStats() {
+    const auto percentile{ [this](std::size_t rank) {
+        std::size_t count{};
+        for (std::size_t i{}; i < s_bucketCount; ++i) {
+            count += m_buckets[i];
+            // Report the upper edge of the bucket, 50 us is the resolution of the histogram.
+            if (count > rank) return std::chrono::nanoseconds{ s_bucketWidth } * (i + 1);
+        }
+        return std::chrono::nanoseconds{ s_bucketWidth } * s_bucketCount;
+    } };
+
+    m_stats.p50 = percentile(m_windowFill / 2);
+    m_stats.p99 = percentile(m_windowFill * 99 / 100);
+    m_stats.max = std::chrono::nanoseconds{
+        *std::max_element(m_window.begin(), m_window.begin() + m_windowFill)
+    };
+}
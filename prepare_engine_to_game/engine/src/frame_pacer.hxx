@@ -0,0 +1,68 @@
+#ifndef ENGINE_PREPARE_TO_GAME_FRAME_PACER_HXX
+#define ENGINE_PREPARE_TO_GAME_FRAME_PACER_HXX
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+// Holds the frame rate on an arbitrary target with nanosecond deadlines. The wait sleeps while
+// the deadline is farther than the measured sleep overshoot and spins for the rest.
+// Every frame interval goes into a sliding-window histogram for the p50/p99/max statistics.
+class FramePacer final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t s_historySize{ 256 };
+    static constexpr std::size_t s_windowSize{ 1024 };
+    static constexpr std::chrono::microseconds s_bucketWidth{ 50 };
+    static constexpr std::size_t s_bucketCount{ 1000 }; // last bucket collects everything >= 50 ms
+
+    struct Stats
+    {
+        std::chrono::nanoseconds p50{};
+        std::chrono::nanoseconds p99{};
+        std::chrono::nanoseconds max{};
+    };
+
+private:
+    Clock::time_point m_deadline{ Clock::now() };
+    Clock::time_point m_lastFrameEnd{ m_deadline };
+
+    // Sleep overshoot estimate (mean + stddev, Welford), the spin phase covers it.
+    double m_sleepMean{ 1e-3 };
+    double m_sleepM2{};
+    std::int64_t m_sleepCount{ 1 };
+    double m_spinThreshold{ 1e-3 };
+
+    std::array<std::int64_t, s_windowSize> m_window{};
+    std::size_t m_windowHead{};
+    std::size_t m_windowFill{};
+    std::array<std::uint16_t, s_bucketCount> m_buckets{};
+
+    std::array<float, s_historySize> m_historyMs{};
+    std::size_t m_historyHead{};
+
+    Stats m_stats{};
+
+public:
+    // Blocks until the next frame deadline. framerate <= 0 means no limit, the frame
+    // interval is still recorded.
+    void wait(int framerate);
+
+    [[nodiscard]] const Stats& getStats() const noexcept { return m_stats; }
+    [[nodiscard]] const std::array<float, s_historySize>& getHistory() const noexcept {
+        return m_historyMs;
+    }
+    // Index of the oldest sample in the history ring.
+    [[nodiscard]] std::size_t getHistoryOffset() const noexcept { return m_historyHead; }
+
+private:
+    void sleepUntil(Clock::time_point deadline);
+    void record(std::chrono::nanoseconds frameTime);
+    void updateStats();
+
+    static std::size_t toBucket(std::int64_t frameTimeNs) noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_FRAME_PACER_HXX
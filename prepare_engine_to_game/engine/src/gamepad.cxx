@@ -0,0 +1,116 @@
+#include "gamepad.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals;
+
+// Event::Gamepad enums follow the order of the SDL ones, translation is a range check.
+static_assert(SDL_GAMEPAD_BUTTON_A == static_cast<int>(Event::Gamepad::Button::a));
+static_assert(SDL_GAMEPAD_BUTTON_DPAD_RIGHT == static_cast<int>(Event::Gamepad::Button::dpad_right));
+static_assert(SDL_GAMEPAD_AXIS_LEFTX == static_cast<int>(Event::Gamepad::Axis::left_x));
+static_assert(SDL_GAMEPAD_AXIS_RIGHT_TRIGGER ==
+              static_cast<int>(Event::Gamepad::Axis::right_trigger));
+
+// Axis jitter below this step isn't reported.
+static constexpr float s_axisEpsilon{ 1.0f / 512.0f };
+
+Gamepads::~Gamepads() { closeAll(); }
+
+void Gamepads::setDeadzone(float deadzone) {
+    if (deadzone < 0.0f || deadzone >= 1.0f)
+        throw std::runtime_error{ "Error : Gamepads::setDeadzone : deadzone should be in [0, 1)"s };
+    m_deadzone = deadzone;
+}
+
+std::optional<Event> Gamepads::handle(const SDL_Event& sdlEvent) {
+    Event event{};
+    switch (sdlEvent.type) {
+    case SDL_EVENT_GAMEPAD_ADDED: {
+        if (find(sdlEvent.gdevice.which) != nullptr) return std::nullopt;
+
+        Pad* free{ find(0) };
+        if (free == nullptr) return std::nullopt;
+
+        free->gamepad = SDL_OpenGamepad(sdlEvent.gdevice.which);
+        if (free->gamepad == nullptr) return std::nullopt;
+
+        free->id = sdlEvent.gdevice.which;
+        free->axes = {};
+        event.type = Event::Type::gamepad_added;
+        event.gamepad.id = free->id;
+        return event;
+    }
+
+    case SDL_EVENT_GAMEPAD_REMOVED: {
+        Pad* pad{ find(sdlEvent.gdevice.which) };
+        if (pad == nullptr) return std::nullopt;
+
+        SDL_CloseGamepad(pad->gamepad);
+        *pad = {};
+        event.type = Event::Type::gamepad_removed;
+        event.gamepad.id = sdlEvent.gdevice.which;
+        return event;
+    }
+
+    case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+    case SDL_EVENT_GAMEPAD_BUTTON_UP:
+        if (find(sdlEvent.gbutton.which) == nullptr ||
+            sdlEvent.gbutton.button >= static_cast<int>(Event::Gamepad::Button::not_button))
+            return std::nullopt;
+
+        event.type = sdlEvent.type == SDL_EVENT_GAMEPAD_BUTTON_DOWN
+                         ? Event::Type::gamepad_button_down
+                         : Event::Type::gamepad_button_up;
+        event.gamepad.id = sdlEvent.gbutton.which;
+        event.gamepad.button = static_cast<Event::Gamepad::Button>(sdlEvent.gbutton.button);
+        return event;
+
+    case SDL_EVENT_GAMEPAD_AXIS_MOTION: {
+        Pad* pad{ find(sdlEvent.gaxis.which) };
+        if (pad == nullptr ||
+            sdlEvent.gaxis.axis >= static_cast<int>(Event::Gamepad::Axis::not_axis))
+            return std::nullopt;
+
+        const auto axis{ static_cast<Event::Gamepad::Axis>(sdlEvent.gaxis.axis) };
+        const float value{ applyDeadzone(
+            std::max(static_cast<float>(sdlEvent.gaxis.value) / 32767.0f, -1.0f)) };
+
+        auto& last{ pad->axes[static_cast<std::size_t>(axis)] };
+        if (std::abs(value - last) < s_axisEpsilon && (value != 0.0f || last == 0.0f))
+            return std::nullopt;
+        last = value;
+
+        event.type = Event::Type::gamepad_axis;
+        event.gamepad.id = pad->id;
+        event.gamepad.axis = axis;
+        event.gamepad.value = value;
+        return event;
+    }
+
+    default:
+        return std::nullopt;
+    }
+}
+
+void Gamepads::closeAll() {
+    for (auto& pad : m_pads) {
+        if (pad.gamepad != nullptr) SDL_CloseGamepad(pad.gamepad);
+        pad = {};
+    }
+}
+
+Gamepads::Pad* Gamepads::find(SDL_JoystickID id) noexcept {
+    for (auto& pad : m_pads)
+        if (pad.id == id) return &pad;
+    return nullptr;
+}
+
+float Gamepads::applyDeadzone(float value) const noexcept {
+    // Rescaled so the output still covers the whole range outside the deadzone.
+    const float magnitude{ std::abs(value) };
+    if (magnitude <= m_deadzone) return 0.0f;
+    return std::copysign((magnitude - m_deadzone) / (1.0f - m_deadzone), value);
+}
@@ -0,0 +1,48 @@
+#ifndef ENGINE_PREPARE_TO_GAME_GAMEPAD_HXX
+#define ENGINE_PREPARE_TO_GAME_GAMEPAD_HXX
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <optional>
+
+#include "engine.hxx"
+
+// Open gamepads and the last reported value of every axis. SDL sends GAMEPAD_ADDED for the pads
+// connected at startup too, so startup and hot plug go through the same path.
+class Gamepads final
+{
+private:
+    struct Pad
+    {
+        SDL_Gamepad* gamepad{};
+        SDL_JoystickID id{};
+        std::array<float, InputState::s_gamepadAxisCount> axes{};
+    };
+
+    std::array<Pad, InputState::s_maxGamepads> m_pads{};
+    float m_deadzone{ 0.15f };
+
+public:
+    Gamepads() = default;
+    ~Gamepads();
+
+    Gamepads(const Gamepads&) = delete;
+    Gamepads& operator=(const Gamepads&) = delete;
+
+    // Fraction of the axis range around the rest position that reads as 0, [0, 1).
+    void setDeadzone(float deadzone);
+    [[nodiscard]] float getDeadzone() const noexcept { return m_deadzone; }
+
+    // Event for a gamepad SDL event, nullopt for other events, pads over the limit and axis
+    // motion that doesn't change the filtered value.
+    std::optional<Event> handle(const SDL_Event& sdlEvent);
+
+    void closeAll();
+
+private:
+    Pad* find(SDL_JoystickID id) noexcept;
+    [[nodiscard]] float applyDeadzone(float value) const noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_GAMEPAD_HXX
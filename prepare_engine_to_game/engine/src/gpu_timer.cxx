@@ -0,0 +1,116 @@
+#include "gpu_timer.hxx"
+
+#include <SDL3/SDL.h>
+
+#include <string_view>
+
+#include "opengl_check.hxx"
+
+#ifndef GL_TIME_ELAPSED_EXT
+#    define GL_TIME_ELAPSED_EXT 0x88BF
+#endif
+#ifndef GL_GPU_DISJOINT_EXT
+#    define GL_GPU_DISJOINT_EXT 0x8FBB
+#endif
+
+void GpuTimer::initialize() {
+    const std::string_view platform{ SDL_GetPlatform() };
+    const bool hasDisjointQuery{ SDL_GL_ExtensionSupported("GL_EXT_disjoint_timer_query") ==
+                                 SDL_TRUE };
+    // Timer queries are core since 3.3, the macOS context is 4.1 core.
+    const bool hasTimerQuery{ hasDisjointQuery ||
+                              SDL_GL_ExtensionSupported("GL_ARB_timer_query") == SDL_TRUE ||
+                              platform == "macOS" };
+    if (!hasTimerQuery) return;
+
+    m_getQueryObjectui64v = reinterpret_cast<GetQueryObjectui64v>(
+        SDL_GL_GetProcAddress(hasDisjointQuery ? "glGetQueryObjectui64vEXT"
+                                               : "glGetQueryObjectui64v"));
+    if (m_getQueryObjectui64v == nullptr || glGenQueries == nullptr || glBeginQuery == nullptr)
+        return;
+
+    for (auto& set : m_sets) {
+        glGenQueries(static_cast<GLsizei>(set.queries.size()), set.queries.data());
+        openGLCheck();
+    }
+
+    m_hasDisjointFlag = hasDisjointQuery;
+    m_isAvailable = true;
+}
+
+void GpuTimer::uninitialize() {
+    if (!m_isAvailable) return;
+
+    for (auto& set : m_sets) {
+        glDeleteQueries(static_cast<GLsizei>(set.queries.size()), set.queries.data());
+        openGLCheck();
+        set = {};
+    }
+
+    m_isAvailable = false;
+    m_results.clear();
+}
+
+void GpuTimer::begin(const char* name) {
+    if (!m_isAvailable) return;
+    if (m_isScopeActive) {
+        ++m_ignoredDepth;
+        return;
+    }
+
+    auto& set{ m_sets[m_current] };
+    if (set.count == s_maxScopes) return;
+
+    set.names[set.count] = name;
+    glBeginQuery(GL_TIME_ELAPSED_EXT, set.queries[set.count]);
+    openGLCheck();
+    m_isScopeActive = true;
+}
+
+void GpuTimer::end() {
+    if (m_ignoredDepth > 0) {
+        --m_ignoredDepth;
+        return;
+    }
+    if (!m_isScopeActive) return;
+
+    glEndQuery(GL_TIME_ELAPSED_EXT);
+    openGLCheck();
+    ++m_sets[m_current].count;
+    m_isScopeActive = false;
+}
+
+void GpuTimer::newFrame() {
+    if (!m_isAvailable) return;
+
+    // Results are reported once, a frame whose set is not ready yet reports nothing.
+    m_results.clear();
+    m_ignoredDepth = 0;
+    end();
+    m_current = (m_current + 1) % s_bufferCount;
+    collect(m_sets[m_current]);
+    m_sets[m_current].count = 0;
+}
+
+void GpuTimer::collect(QuerySet& set) {
+    if (set.count == 0) return;
+
+    // The last query of the set finishes last, if it is ready the whole set is.
+    GLuint isReady{};
+    glGetQueryObjectuiv(set.queries[set.count - 1], GL_QUERY_RESULT_AVAILABLE, &isReady);
+    openGLCheck();
+    if (isReady == GL_FALSE) return;
+
+    // A disjoint event (power state change, context loss) makes the results meaningless.
+    if (m_hasDisjointFlag) {
+        GLint isDisjoint{};
+        glGetIntegerv(GL_GPU_DISJOINT_EXT, &isDisjoint);
+        if (isDisjoint != 0) return;
+    }
+
+    for (std::size_t i{}; i < set.count; ++i) {
+        GLuint64 duration{};
+        m_getQueryObjectui64v(set.queries[i], GL_QUERY_RESULT, &duration);
+        m_results.push_back({ .name = set.names[i], .durationNs = duration });
+    }
+}
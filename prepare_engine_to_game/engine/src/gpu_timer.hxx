@@ -0,0 +1,68 @@
+#ifndef ENGINE_PREPARE_TO_GAME_GPU_TIMER_HXX
+#define ENGINE_PREPARE_TO_GAME_GPU_TIMER_HXX
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// GL_TIME_ELAPSED queries (EXT_disjoint_timer_query on GLES, ARB_timer_query / core on desktop).
+// Queries of a frame are read back at the end of the next frame, when their set is about to be
+// reused, and only if the driver reports them as available - the CPU never waits for the GPU.
+// Without the extension every call is a no-op and isAvailable() returns false.
+class GpuTimer final
+{
+public:
+    struct Result
+    {
+        const char* name{};
+        std::uint64_t durationNs{};
+    };
+
+private:
+    static constexpr std::size_t s_bufferCount{ 2 };
+    static constexpr std::size_t s_maxScopes{ 16 };
+
+    struct QuerySet
+    {
+        std::array<GLuint, s_maxScopes> queries{};
+        std::array<const char*, s_maxScopes> names{};
+        std::size_t count{};
+    };
+
+    using GetQueryObjectui64v = void (*)(GLuint id, GLenum pname, GLuint64* params);
+
+    std::array<QuerySet, s_bufferCount> m_sets{};
+    std::size_t m_current{};
+    bool m_isAvailable{};
+    bool m_isScopeActive{};
+    int m_ignoredDepth{};
+    bool m_hasDisjointFlag{};
+    GetQueryObjectui64v m_getQueryObjectui64v{};
+
+    std::vector<Result> m_results{};
+
+public:
+    // Needs a current GL context.
+    void initialize();
+    void uninitialize();
+
+    [[nodiscard]] bool isAvailable() const noexcept { return m_isAvailable; }
+
+    // Scopes can't nest, a nested begin is ignored together with its end.
+    void begin(const char* name);
+    void end();
+
+    // Call after the frame is submitted. Reads back the set that is about to be reused.
+    void newFrame();
+
+    // Results collected by the last newFrame (empty when its set was not ready yet), they lag
+    // behind the CPU by the buffer count.
+    [[nodiscard]] const std::vector<Result>& getResults() const noexcept { return m_results; }
+
+private:
+    void collect(QuerySet& set);
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_GPU_TIMER_HXX
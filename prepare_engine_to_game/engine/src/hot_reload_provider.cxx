@@ -3,6 +3,8 @@
 
 #    include <boost/json.hpp>
 
+#    include "profiler.hxx"
+
 #    include <algorithm>
 #    include <fstream>
 #    include <ranges>
@@ -17,6 +19,7 @@ HotReloadProvider::HotReloadProvider(fs::path path) : m_configPath{ std::move(pa
 }
 
 void HotReloadProvider::check() {
+    ENGINE_PROFILE_SCOPE("HotReloadProvider::check");
     configFileChanged();
     std::ranges::for_each(m_map, [](const auto& el) {
         if (el.second.fn) el.second.fn();
@@ -0,0 +1,292 @@
+#include "input_recording.hxx"
+
+#include <array>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals;
+
+static constexpr std::array<char, 4> s_magic{ 'P', 'G', 'I', 'R' };
+static constexpr std::uint16_t s_version{ 2 };
+// Type of the frame time records, past every Event::Type.
+static constexpr std::uint8_t s_frameTimeType{ 0xFF };
+static_assert(static_cast<std::uint8_t>(Event::Type::not_event) < s_frameTimeType);
+
+static void writeVarint(std::ostream& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.put(static_cast<char>(value));
+}
+
+template <typename T>
+static void writeLittleEndian(std::ostream& out, T value) {
+    for (std::size_t i{}; i < sizeof(T); ++i)
+        out.put(static_cast<char>((static_cast<std::uint64_t>(value) >> (8 * i)) & 0xFF));
+}
+
+static void writeFloat(std::ostream& out, float value) {
+    writeLittleEndian(out, std::bit_cast<std::uint32_t>(value));
+}
+
+static std::uint64_t readVarint(std::istream& in) {
+    std::uint64_t value{};
+    for (int shift{}; shift < 64; shift += 7) {
+        const int byte{ in.get() };
+        if (byte == std::char_traits<char>::eof())
+            throw std::runtime_error{ "Error : InputReplay : unexpected end of file"s };
+
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return value;
+    }
+    throw std::runtime_error{ "Error : InputReplay : bad varint"s };
+}
+
+template <typename T>
+static T readLittleEndian(std::istream& in) {
+    std::uint64_t value{};
+    for (std::size_t i{}; i < sizeof(T); ++i) {
+        const int byte{ in.get() };
+        if (byte == std::char_traits<char>::eof())
+            throw std::runtime_error{ "Error : InputReplay : unexpected end of file"s };
+        value |= static_cast<std::uint64_t>(byte) << (8 * i);
+    }
+    return static_cast<T>(value);
+}
+
+static float readFloat(std::istream& in) {
+    return std::bit_cast<float>(readLittleEndian<std::uint32_t>(in));
+}
+
+InputRecorder::InputRecorder(const std::filesystem::path& path, std::uint64_t randomSeed)
+    : m_out{ path, std::ios::binary }
+    , m_start{ std::chrono::steady_clock::now() } {
+    if (!m_out.is_open()) throw std::runtime_error{ "Error : InputRecorder : bad open file"s };
+
+    m_out.write(s_magic.data(), s_magic.size());
+    writeLittleEndian(m_out, s_version);
+    writeLittleEndian(m_out, std::uint16_t{});
+    writeLittleEndian(m_out, randomSeed);
+}
+
+void InputRecorder::writeRecordStart(std::uint64_t frame) {
+    const auto timestampUs{ std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - m_start)
+                                .count() };
+
+    writeVarint(m_out, frame - m_lastFrame);
+    writeVarint(m_out, static_cast<std::uint64_t>(timestampUs - m_lastTimestampUs));
+    m_lastFrame = frame;
+    m_lastTimestampUs = timestampUs;
+}
+
+void InputRecorder::recordFrameTime(std::uint64_t frame, std::chrono::nanoseconds frameTime) {
+    if (!isOpen()) return;
+
+    writeRecordStart(frame);
+    m_out.put(static_cast<char>(s_frameTimeType));
+    writeVarint(m_out, static_cast<std::uint64_t>(frameTime.count()));
+}
+
+void InputRecorder::record(std::uint64_t frame, const Event& event) {
+    if (!isOpen()) return;
+
+    writeRecordStart(frame);
+    m_out.put(static_cast<char>(event.type));
+    switch (event.type) {
+    case Event::Type::key_down:
+    case Event::Type::key_up:
+        m_out.put(static_cast<char>(event.keyboard.key));
+        break;
+
+    case Event::Type::mouse_down:
+    case Event::Type::mouse_up:
+    case Event::Type::mouse_motion:
+        m_out.put(static_cast<char>(event.mouse.button));
+        writeFloat(m_out, event.mouse.pos.x);
+        writeFloat(m_out, event.mouse.pos.y);
+        break;
+
+    case Event::Type::mouse_wheel:
+        writeFloat(m_out, event.mouse.wheel.x);
+        writeFloat(m_out, event.mouse.wheel.y);
+        break;
+
+    case Event::Type::touch_down:
+    case Event::Type::touch_up:
+    case Event::Type::touch_motion:
+        writeVarint(m_out, event.touch.id);
+        writeFloat(m_out, event.touch.pos.x);
+        writeFloat(m_out, event.touch.pos.y);
+        writeFloat(m_out, event.touch.dx);
+        writeFloat(m_out, event.touch.dy);
+        break;
+
+    case Event::Type::gamepad_added:
+    case Event::Type::gamepad_removed:
+        writeVarint(m_out, event.gamepad.id);
+        break;
+
+    case Event::Type::gamepad_button_down:
+    case Event::Type::gamepad_button_up:
+        writeVarint(m_out, event.gamepad.id);
+        m_out.put(static_cast<char>(event.gamepad.button));
+        break;
+
+    case Event::Type::gamepad_axis:
+        writeVarint(m_out, event.gamepad.id);
+        m_out.put(static_cast<char>(event.gamepad.axis));
+        writeFloat(m_out, event.gamepad.value);
+        break;
+
+    case Event::Type::gesture_tap:
+    case Event::Type::gesture_pinch:
+        writeFloat(m_out, event.gesture.pos.x);
+        writeFloat(m_out, event.gesture.pos.y);
+        writeFloat(m_out, event.gesture.scale);
+        break;
+
+    case Event::Type::gesture_drag:
+        writeFloat(m_out, event.gesture.pos.x);
+        writeFloat(m_out, event.gesture.pos.y);
+        writeFloat(m_out, event.gesture.dx);
+        writeFloat(m_out, event.gesture.dy);
+        break;
+
+    case Event::Type::window_resized:
+        writeVarint(m_out, static_cast<std::uint64_t>(event.window.width));
+        writeVarint(m_out, static_cast<std::uint64_t>(event.window.height));
+        break;
+
+    default:
+        break;
+    }
+}
+
+InputReplay::InputReplay(const std::filesystem::path& path) {
+    std::ifstream in{ path, std::ios::binary };
+    if (!in.is_open()) throw std::runtime_error{ "Error : InputReplay : bad open file"s };
+
+    std::array<char, 4> magic{};
+    in.read(magic.data(), magic.size());
+    if (!in || magic != s_magic) throw std::runtime_error{ "Error : InputReplay : bad magic"s };
+
+    if (readLittleEndian<std::uint16_t>(in) != s_version)
+        throw std::runtime_error{ "Error : InputReplay : unsupported version"s };
+    readLittleEndian<std::uint16_t>(in);
+    m_randomSeed = readLittleEndian<std::uint64_t>(in);
+
+    Entry entry{};
+    while (in.peek() != std::char_traits<char>::eof()) {
+        entry.frame += readVarint(in);
+        entry.timestampUs += static_cast<std::int64_t>(readVarint(in));
+
+        const auto type{ readLittleEndian<std::uint8_t>(in) };
+        if (type == s_frameTimeType) {
+            if (entry.frame != m_frameTimes.size())
+                throw std::runtime_error{ "Error : InputReplay : frame time out of order"s };
+            m_frameTimes.emplace_back(static_cast<std::int64_t>(readVarint(in)));
+            continue;
+        }
+
+        auto& event{ entry.event };
+        event = Event{};
+        event.type = static_cast<Event::Type>(type);
+        switch (event.type) {
+        case Event::Type::key_down:
+        case Event::Type::key_up:
+            event.keyboard.key =
+                static_cast<Event::Keyboard::Key>(readLittleEndian<std::uint8_t>(in));
+            break;
+
+        case Event::Type::mouse_down:
+        case Event::Type::mouse_up:
+        case Event::Type::mouse_motion:
+            event.mouse.button =
+                static_cast<Event::Mouse::Button>(readLittleEndian<std::uint8_t>(in));
+            event.mouse.pos.x = readFloat(in);
+            event.mouse.pos.y = readFloat(in);
+            break;
+
+        case Event::Type::mouse_wheel:
+            event.mouse.wheel.x = readFloat(in);
+            event.mouse.wheel.y = readFloat(in);
+            break;
+
+        case Event::Type::touch_down:
+        case Event::Type::touch_up:
+        case Event::Type::touch_motion:
+            event.touch.id = readVarint(in);
+            event.touch.pos.x = readFloat(in);
+            event.touch.pos.y = readFloat(in);
+            event.touch.dx = readFloat(in);
+            event.touch.dy = readFloat(in);
+            break;
+
+        case Event::Type::gamepad_added:
+        case Event::Type::gamepad_removed:
+            event.gamepad.id = static_cast<std::uint32_t>(readVarint(in));
+            break;
+
+        case Event::Type::gamepad_button_down:
+        case Event::Type::gamepad_button_up:
+            event.gamepad.id = static_cast<std::uint32_t>(readVarint(in));
+            event.gamepad.button =
+                static_cast<Event::Gamepad::Button>(readLittleEndian<std::uint8_t>(in));
+            if (event.gamepad.button >= Event::Gamepad::Button::not_button)
+                throw std::runtime_error{ "Error : InputReplay : bad gamepad button"s };
+            break;
+
+        case Event::Type::gamepad_axis:
+            event.gamepad.id = static_cast<std::uint32_t>(readVarint(in));
+            event.gamepad.axis =
+                static_cast<Event::Gamepad::Axis>(readLittleEndian<std::uint8_t>(in));
+            if (event.gamepad.axis >= Event::Gamepad::Axis::not_axis)
+                throw std::runtime_error{ "Error : InputReplay : bad gamepad axis"s };
+            event.gamepad.value = readFloat(in);
+            break;
+
+        case Event::Type::gesture_tap:
+        case Event::Type::gesture_pinch:
+            event.gesture.pos.x = readFloat(in);
+            event.gesture.pos.y = readFloat(in);
+            event.gesture.scale = readFloat(in);
+            break;
+
+        case Event::Type::gesture_drag:
+            event.gesture.pos.x = readFloat(in);
+            event.gesture.pos.y = readFloat(in);
+            event.gesture.dx = readFloat(in);
+            event.gesture.dy = readFloat(in);
+            break;
+
+        case Event::Type::window_resized:
+            event.window.width = static_cast<int>(readVarint(in));
+            event.window.height = static_cast<int>(readVarint(in));
+            break;
+
+        case Event::Type::turn_off:
+            break;
+
+        default:
+            throw std::runtime_error{ "Error : InputReplay : bad event type"s };
+        }
+
+        m_entries.push_back(entry);
+    }
+
+    m_isOpen = true;
+}
+
+std::optional<Event> InputReplay::poll(std::uint64_t frame) {
+    if (m_next == m_entries.size() || m_entries[m_next].frame > frame) return std::nullopt;
+    return m_entries[m_next++].event;
+}
+
+std::optional<std::chrono::nanoseconds> InputReplay::getFrameTime(
+    std::uint64_t frame) const noexcept {
+    if (frame >= m_frameTimes.size()) return std::nullopt;
+    return m_frameTimes[frame];
+}
@@ -0,0 +1,76 @@
+#ifndef ENGINE_PREPARE_TO_GAME_INPUT_RECORDING_HXX
+#define ENGINE_PREPARE_TO_GAME_INPUT_RECORDING_HXX
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <vector>
+
+#include "engine.hxx"
+
+// Binary input recording, little-endian:
+//     header: "PGIR", u16 version, u16 reserved, u64 random seed
+//     record: varint frame delta, varint timestamp delta (us), u8 event type, payload
+// Payload depends on the type: key - u8; mouse button/motion - u8 button, f32 x, f32 y;
+// wheel - f32 x, f32 y; touch - varint id, f32 x, f32 y, f32 dx, f32 dy; gamepad hot plug -
+// varint id; gamepad button - varint id, u8 button; gamepad axis - varint id, u8 axis, f32 value;
+// tap/pinch - f32 x, f32 y, f32 scale; drag - f32 x, f32 y, f32 dx, f32 dy; window resize -
+// varint width, varint height.
+// Every frame also gets a record of type 0xFF with the varint frame time (ns) as payload, so a
+// replay runs the same number of fixed updates per frame.
+// Deltas keep a typical record at 3-4 bytes for keys.
+class InputRecorder final
+{
+private:
+    std::ofstream m_out{};
+    std::uint64_t m_lastFrame{};
+    std::int64_t m_lastTimestampUs{};
+    std::chrono::steady_clock::time_point m_start{};
+
+public:
+    InputRecorder() = default;
+    InputRecorder(const std::filesystem::path& path, std::uint64_t randomSeed);
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_out.is_open(); }
+
+    void record(std::uint64_t frame, const Event& event);
+    // Once per frame, frames must be recorded in order from 0.
+    void recordFrameTime(std::uint64_t frame, std::chrono::nanoseconds frameTime);
+
+private:
+    void writeRecordStart(std::uint64_t frame);
+};
+
+class InputReplay final
+{
+private:
+    struct Entry
+    {
+        std::uint64_t frame{};
+        std::int64_t timestampUs{};
+        Event event{};
+    };
+
+    std::vector<Entry> m_entries{};
+    std::vector<std::chrono::nanoseconds> m_frameTimes{}; // by frame
+    std::size_t m_next{};
+    std::uint64_t m_randomSeed{};
+    bool m_isOpen{};
+
+public:
+    InputReplay() = default;
+    explicit InputReplay(const std::filesystem::path& path);
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_isOpen; }
+    [[nodiscard]] std::uint64_t getRandomSeed() const noexcept { return m_randomSeed; }
+
+    // Next recorded event of the frame, the events of later frames stay queued.
+    std::optional<Event> poll(std::uint64_t frame);
+    // Recorded frame time, none past the end of the recording.
+    [[nodiscard]] std::optional<std::chrono::nanoseconds> getFrameTime(
+        std::uint64_t frame) const noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_INPUT_RECORDING_HXX
@@ -0,0 +1,78 @@
+#include "input_script.hxx"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals;
+
+static Event::Mouse::Button strToButton(std::string_view str) {
+    if (str == "left"sv) return Event::Mouse::Button::left;
+    if (str == "right"sv) return Event::Mouse::Button::right;
+    if (str == "middle"sv) return Event::Mouse::Button::middle;
+    return Event::Mouse::Button::not_button;
+}
+
+InputScript::InputScript(const std::filesystem::path& path) {
+    std::ifstream in{ path };
+    if (!in.is_open()) throw std::runtime_error{ "Error : InputScript : bad open file"s };
+
+    std::string line{};
+    for (std::size_t lineNumber{ 1 }; std::getline(in, line); ++lineNumber) {
+        if (auto comment{ line.find('#') }; comment != std::string::npos) line.erase(comment);
+
+        std::istringstream lineStream{ line };
+        Entry entry{};
+        std::string type{};
+        if (!(lineStream >> entry.frame)) continue;
+        lineStream >> type;
+
+        auto& event{ entry.event };
+        if (type == "key_down"sv || type == "key_up"sv) {
+            std::string key{};
+            lineStream >> key;
+            event.type = type == "key_down"sv ? Event::Type::key_down : Event::Type::key_up;
+            event.keyboard.key = strToKey(key);
+            if (event.keyboard.key == Event::Keyboard::Key::not_key)
+                lineStream.setstate(std::ios::failbit);
+        }
+        else if (type == "mouse_down"sv || type == "mouse_up"sv) {
+            std::string button{};
+            lineStream >> button >> event.mouse.pos.x >> event.mouse.pos.y;
+            event.type = type == "mouse_down"sv ? Event::Type::mouse_down : Event::Type::mouse_up;
+            event.mouse.button = strToButton(button);
+            if (event.mouse.button == Event::Mouse::Button::not_button)
+                lineStream.setstate(std::ios::failbit);
+        }
+        else if (type == "mouse_motion"sv) {
+            lineStream >> event.mouse.pos.x >> event.mouse.pos.y;
+            event.type = Event::Type::mouse_motion;
+        }
+        else if (type == "mouse_wheel"sv) {
+            lineStream >> event.mouse.wheel.x >> event.mouse.wheel.y;
+            event.type = Event::Type::mouse_wheel;
+        }
+        else if (type == "touch_down"sv || type == "touch_up"sv || type == "touch_motion"sv) {
+            lineStream >> event.touch.id >> event.touch.pos.x >> event.touch.pos.y;
+            event.type = type == "touch_down"sv ? Event::Type::touch_down
+                         : type == "touch_up"sv ? Event::Type::touch_up
+                                                : Event::Type::touch_motion;
+        }
+        else if (type == "quit"sv)
+            event.type = Event::Type::turn_off;
+        else
+            lineStream.setstate(std::ios::failbit);
+
+        if (lineStream.fail() || (!m_entries.empty() && entry.frame < m_entries.back().frame))
+            throw std::runtime_error{ "Error : InputScript : bad line "s +
+                                      std::to_string(lineNumber) };
+
+        m_entries.push_back(entry);
+    }
+}
+
+std::optional<Event> InputScript::poll(std::uint64_t frame) {
+    if (m_next == m_entries.size() || m_entries[m_next].frame > frame) return std::nullopt;
+    return m_entries[m_next++].event;
+}
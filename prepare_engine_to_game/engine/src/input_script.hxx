@@ -0,0 +1,42 @@
+#ifndef ENGINE_PREPARE_TO_GAME_INPUT_SCRIPT_HXX
+#define ENGINE_PREPARE_TO_GAME_INPUT_SCRIPT_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include "engine.hxx"
+
+// Text script of input events for unattended runs, one event per line:
+//     <frame> key_down|key_up <key>             e.g. "120 key_down w"
+//     <frame> mouse_down|mouse_up <button> <x> <y>
+//     <frame> mouse_motion <x> <y>
+//     <frame> mouse_wheel <x> <y>
+//     <frame> touch_down|touch_up|touch_motion <id> <x> <y>
+//     <frame> quit
+// Frames must not decrease, '#' starts a comment.
+class InputScript final
+{
+private:
+    struct Entry
+    {
+        std::uint64_t frame{};
+        Event event{};
+    };
+
+    std::vector<Entry> m_entries{};
+    std::size_t m_next{};
+
+public:
+    InputScript() = default;
+    explicit InputScript(const std::filesystem::path& path);
+
+    [[nodiscard]] bool isLoaded() const noexcept { return !m_entries.empty(); }
+
+    // Next event scheduled on or before the frame.
+    std::optional<Event> poll(std::uint64_t frame);
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_INPUT_SCRIPT_HXX
@@ -0,0 +1,240 @@
+#ifndef ENGINE_PREPARE_TO_GAME_KEY_TABLE_HXX
+#define ENGINE_PREPARE_TO_GAME_KEY_TABLE_HXX
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "engine.hxx"
+
+// One row per Event::Keyboard::Key, in the order of the enum:
+//     X(key, SDL keycode, SDL scancode, ImGuiKey, name)
+// Every translation table below is generated from this list at compile time.
+#define ENGINE_KEY_LIST(X)                                                                 \
+    X(q, SDLK_q, SDL_SCANCODE_Q, ImGuiKey_Q, "q_")                                         \
+    X(w, SDLK_w, SDL_SCANCODE_W, ImGuiKey_W, "w_")                                         \
+    X(e, SDLK_e, SDL_SCANCODE_E, ImGuiKey_E, "e_")                                         \
+    X(r, SDLK_r, SDL_SCANCODE_R, ImGuiKey_R, "r_")                                         \
+    X(t, SDLK_t, SDL_SCANCODE_T, ImGuiKey_T, "t_")                                         \
+    X(y, SDLK_y, SDL_SCANCODE_Y, ImGuiKey_Y, "y_")                                         \
+    X(u, SDLK_u, SDL_SCANCODE_U, ImGuiKey_U, "u_")                                         \
+    X(i, SDLK_i, SDL_SCANCODE_I, ImGuiKey_I, "i_")                                         \
+    X(o, SDLK_o, SDL_SCANCODE_O, ImGuiKey_O, "o_")                                         \
+    X(p, SDLK_p, SDL_SCANCODE_P, ImGuiKey_P, "p_")                                         \
+    X(a, SDLK_a, SDL_SCANCODE_A, ImGuiKey_A, "a_")                                         \
+    X(s, SDLK_s, SDL_SCANCODE_S, ImGuiKey_S, "s_")                                         \
+    X(d, SDLK_d, SDL_SCANCODE_D, ImGuiKey_D, "d_")                                         \
+    X(f, SDLK_f, SDL_SCANCODE_F, ImGuiKey_F, "f_")                                         \
+    X(g, SDLK_g, SDL_SCANCODE_G, ImGuiKey_G, "g_")                                         \
+    X(h, SDLK_h, SDL_SCANCODE_H, ImGuiKey_H, "h_")                                         \
+    X(j, SDLK_j, SDL_SCANCODE_J, ImGuiKey_J, "j_")                                         \
+    X(k, SDLK_k, SDL_SCANCODE_K, ImGuiKey_K, "k_")                                         \
+    X(l, SDLK_l, SDL_SCANCODE_L, ImGuiKey_L, "l_")                                         \
+    X(z, SDLK_z, SDL_SCANCODE_Z, ImGuiKey_Z, "z_")                                         \
+    X(x, SDLK_x, SDL_SCANCODE_X, ImGuiKey_X, "x_")                                         \
+    X(c, SDLK_c, SDL_SCANCODE_C, ImGuiKey_C, "c_")                                         \
+    X(v, SDLK_v, SDL_SCANCODE_V, ImGuiKey_V, "v_")                                         \
+    X(b, SDLK_b, SDL_SCANCODE_B, ImGuiKey_B, "b_")                                         \
+    X(n, SDLK_n, SDL_SCANCODE_N, ImGuiKey_N, "n_")                                         \
+    X(m, SDLK_m, SDL_SCANCODE_M, ImGuiKey_M, "m_")                                         \
+    X(space, SDLK_SPACE, SDL_SCANCODE_SPACE, ImGuiKey_Space, "space_")                     \
+    X(enter, SDLK_RETURN, SDL_SCANCODE_RETURN, ImGuiKey_Enter, "enter_")                   \
+    X(l_control, SDLK_LCTRL, SDL_SCANCODE_LCTRL, ImGuiKey_LeftCtrl, "left_control_")       \
+    X(l_shift, SDLK_LSHIFT, SDL_SCANCODE_LSHIFT, ImGuiKey_LeftShift, "left_shift_")        \
+    X(escape, SDLK_ESCAPE, SDL_SCANCODE_ESCAPE, ImGuiKey_Escape, "escape_")                \
+    X(backspace, SDLK_BACKSPACE, SDL_SCANCODE_BACKSPACE, ImGuiKey_Backspace, "backspace_") \
+    X(num_0, SDLK_0, SDL_SCANCODE_0, ImGuiKey_0, "num_0_")                                 \
+    X(num_1, SDLK_1, SDL_SCANCODE_1, ImGuiKey_1, "num_1_")                                 \
+    X(num_2, SDLK_2, SDL_SCANCODE_2, ImGuiKey_2, "num_2_")                                 \
+    X(num_3, SDLK_3, SDL_SCANCODE_3, ImGuiKey_3, "num_3_")                                 \
+    X(num_4, SDLK_4, SDL_SCANCODE_4, ImGuiKey_4, "num_4_")                                 \
+    X(num_5, SDLK_5, SDL_SCANCODE_5, ImGuiKey_5, "num_5_")                                 \
+    X(num_6, SDLK_6, SDL_SCANCODE_6, ImGuiKey_6, "num_6_")                                 \
+    X(num_7, SDLK_7, SDL_SCANCODE_7, ImGuiKey_7, "num_7_")                                 \
+    X(num_8, SDLK_8, SDL_SCANCODE_8, ImGuiKey_8, "num_8_")                                 \
+    X(num_9, SDLK_9, SDL_SCANCODE_9, ImGuiKey_9, "num_9_")                                 \
+    X(f1, SDLK_F1, SDL_SCANCODE_F1, ImGuiKey_F1, "f1_")                                    \
+    X(f2, SDLK_F2, SDL_SCANCODE_F2, ImGuiKey_F2, "f2_")                                    \
+    X(f3, SDLK_F3, SDL_SCANCODE_F3, ImGuiKey_F3, "f3_")                                    \
+    X(f4, SDLK_F4, SDL_SCANCODE_F4, ImGuiKey_F4, "f4_")                                    \
+    X(f5, SDLK_F5, SDL_SCANCODE_F5, ImGuiKey_F5, "f5_")                                    \
+    X(f6, SDLK_F6, SDL_SCANCODE_F6, ImGuiKey_F6, "f6_")                                    \
+    X(f7, SDLK_F7, SDL_SCANCODE_F7, ImGuiKey_F7, "f7_")                                    \
+    X(f8, SDLK_F8, SDL_SCANCODE_F8, ImGuiKey_F8, "f8_")                                    \
+    X(f9, SDLK_F9, SDL_SCANCODE_F9, ImGuiKey_F9, "f9_")                                    \
+    X(f10, SDLK_F10, SDL_SCANCODE_F10, ImGuiKey_F10, "f10_")                               \
+    X(f11, SDLK_F11, SDL_SCANCODE_F11, ImGuiKey_F11, "f11_")                               \
+    X(f12, SDLK_F12, SDL_SCANCODE_F12, ImGuiKey_F12, "f12_")                               \
+    X(up_arrow, SDLK_UP, SDL_SCANCODE_UP, ImGuiKey_UpArrow, "up_arrow_")                   \
+    X(down_arrow, SDLK_DOWN, SDL_SCANCODE_DOWN, ImGuiKey_DownArrow, "down_arrow_")         \
+    X(left_arrow, SDLK_LEFT, SDL_SCANCODE_LEFT, ImGuiKey_LeftArrow, "left_arrow_")         \
+    X(right_arrow, SDLK_RIGHT, SDL_SCANCODE_RIGHT, ImGuiKey_RightArrow, "right_arrow_")     \
+    X(insert, SDLK_INSERT, SDL_SCANCODE_INSERT, ImGuiKey_Insert, "insert_")                \
+    X(home, SDLK_HOME, SDL_SCANCODE_HOME, ImGuiKey_Home, "home_")                          \
+    X(page_up, SDLK_PAGEUP, SDL_SCANCODE_PAGEUP, ImGuiKey_PageUp, "page_up_")              \
+    X(delete_key, SDLK_DELETE, SDL_SCANCODE_DELETE, ImGuiKey_Delete, "delete_key_")        \
+    X(end, SDLK_END, SDL_SCANCODE_END, ImGuiKey_End, "end_")                               \
+    X(page_down, SDLK_PAGEDOWN, SDL_SCANCODE_PAGEDOWN, ImGuiKey_PageDown, "page_down_")    \
+    X(caps_lock, SDLK_CAPSLOCK, SDL_SCANCODE_CAPSLOCK, ImGuiKey_CapsLock, "caps_lock_")    \
+    X(scroll_lock,                                                                         \
+      SDLK_SCROLLLOCK,                                                                     \
+      SDL_SCANCODE_SCROLLLOCK,                                                             \
+      ImGuiKey_ScrollLock,                                                                 \
+      "scroll_lock_")                                                                      \
+    X(num_lock, SDLK_NUMLOCKCLEAR, SDL_SCANCODE_NUMLOCKCLEAR, ImGuiKey_NumLock, "num_lock_") \
+    X(print_screen,                                                                        \
+      SDLK_PRINTSCREEN,                                                                    \
+      SDL_SCANCODE_PRINTSCREEN,                                                            \
+      ImGuiKey_PrintScreen,                                                                \
+      "print_screen_")                                                                     \
+    X(pause, SDLK_PAUSE, SDL_SCANCODE_PAUSE, ImGuiKey_Pause, "pause_")                     \
+    X(numpad_0, SDLK_KP_0, SDL_SCANCODE_KP_0, ImGuiKey_Keypad0, "numpad_0_")               \
+    X(numpad_1, SDLK_KP_1, SDL_SCANCODE_KP_1, ImGuiKey_Keypad1, "numpad_1_")               \
+    X(numpad_2, SDLK_KP_2, SDL_SCANCODE_KP_2, ImGuiKey_Keypad2, "numpad_2_")               \
+    X(numpad_3, SDLK_KP_3, SDL_SCANCODE_KP_3, ImGuiKey_Keypad3, "numpad_3_")               \
+    X(numpad_4, SDLK_KP_4, SDL_SCANCODE_KP_4, ImGuiKey_Keypad4, "numpad_4_")               \
+    X(numpad_5, SDLK_KP_5, SDL_SCANCODE_KP_5, ImGuiKey_Keypad5, "numpad_5_")               \
+    X(numpad_6, SDLK_KP_6, SDL_SCANCODE_KP_6, ImGuiKey_Keypad6, "numpad_6_")               \
+    X(numpad_7, SDLK_KP_7, SDL_SCANCODE_KP_7, ImGuiKey_Keypad7, "numpad_7_")               \
+    X(numpad_8, SDLK_KP_8, SDL_SCANCODE_KP_8, ImGuiKey_Keypad8, "numpad_8_")               \
+    X(numpad_9, SDLK_KP_9, SDL_SCANCODE_KP_9, ImGuiKey_Keypad9, "numpad_9_")               \
+    X(numpad_decimal,                                                                      \
+      SDLK_KP_PERIOD,                                                                      \
+      SDL_SCANCODE_KP_PERIOD,                                                              \
+      ImGuiKey_KeypadDecimal,                                                              \
+      "numpad_decimal_")                                                                   \
+    X(numpad_divide,                                                                       \
+      SDLK_KP_DIVIDE,                                                                      \
+      SDL_SCANCODE_KP_DIVIDE,                                                              \
+      ImGuiKey_KeypadDivide,                                                               \
+      "numpad_divide_")                                                                    \
+    X(numpad_multiply,                                                                     \
+      SDLK_KP_MULTIPLY,                                                                    \
+      SDL_SCANCODE_KP_MULTIPLY,                                                            \
+      ImGuiKey_KeypadMultiply,                                                             \
+      "numpad_multiply_")                                                                  \
+    X(numpad_subtract,                                                                     \
+      SDLK_KP_MINUS,                                                                       \
+      SDL_SCANCODE_KP_MINUS,                                                               \
+      ImGuiKey_KeypadSubtract,                                                             \
+      "numpad_subtract_")                                                                  \
+    X(numpad_add, SDLK_KP_PLUS, SDL_SCANCODE_KP_PLUS, ImGuiKey_KeypadAdd, "numpad_add_")   \
+    X(numpad_enter,                                                                        \
+      SDLK_KP_ENTER,                                                                       \
+      SDL_SCANCODE_KP_ENTER,                                                               \
+      ImGuiKey_KeypadEnter,                                                                \
+      "numpad_enter_")
+
+namespace key_table
+{
+using Key = Event::Keyboard::Key;
+
+struct KeyInfo
+{
+    Key key{};
+    SDL_Keycode keycode{};
+    SDL_Scancode scancode{};
+    ImGuiKey imGuiKey{};
+    std::string_view name{};
+};
+
+inline constexpr std::array s_keys{
+#define ENGINE_KEY_INFO(key, keycode, scancode, imGuiKey, name) \
+    KeyInfo{ Key::key, keycode, scancode, imGuiKey, name },
+    ENGINE_KEY_LIST(ENGINE_KEY_INFO)
+#undef ENGINE_KEY_INFO
+};
+
+inline constexpr std::size_t s_keyCount{ static_cast<std::size_t>(Key::not_key) };
+static_assert(s_keys.size() == s_keyCount, "every key needs a row in ENGINE_KEY_LIST");
+
+// Keycodes are either a character (< 128) or a scancode with SDLK_SCANCODE_MASK set, the table
+// stores both ranges one after another. Other characters, like the 'à' of an AZERTY layout, get
+// an index past the table.
+inline constexpr std::size_t s_characterKeycodeCount{ 128 };
+inline constexpr std::size_t s_keycodeTableSize{ s_characterKeycodeCount + SDL_NUM_SCANCODES };
+
+constexpr std::size_t keycodeIndex(SDL_Keycode keycode) noexcept {
+    const auto code{ static_cast<std::size_t>(keycode) };
+    if ((code & SDLK_SCANCODE_MASK) != 0)
+        return s_characterKeycodeCount + (code & ~std::size_t{ SDLK_SCANCODE_MASK });
+    return code < s_characterKeycodeCount ? code : s_keycodeTableSize;
+}
+
+constexpr std::size_t imGuiKeyIndex(ImGuiKey key) noexcept {
+    return static_cast<std::size_t>(key - ImGuiKey_NamedKey_BEGIN);
+}
+
+consteval bool isOrdered() {
+    for (std::size_t i{}; i < s_keys.size(); ++i)
+        if (s_keys[i].key != static_cast<Key>(i)) return false;
+    return true;
+}
+
+template <std::size_t Size, typename Index>
+consteval bool isUnique(Index index) {
+    std::array<bool, Size> isUsed{};
+    for (const auto& info : s_keys) {
+        const std::size_t i{ index(info) };
+        if (i >= Size || isUsed[i]) return false;
+        isUsed[i] = true;
+    }
+    return true;
+}
+
+static_assert(isOrdered(), "ENGINE_KEY_LIST must follow the order of Event::Keyboard::Key");
+static_assert(isUnique<s_keycodeTableSize>([](const KeyInfo& info) {
+                  return keycodeIndex(info.keycode);
+              }),
+              "duplicate or out of range SDL keycode in ENGINE_KEY_LIST");
+static_assert(isUnique<SDL_NUM_SCANCODES>([](const KeyInfo& info) {
+                  return static_cast<std::size_t>(info.scancode);
+              }),
+              "duplicate or out of range SDL scancode in ENGINE_KEY_LIST");
+static_assert(isUnique<ImGuiKey_NamedKey_COUNT>([](const KeyInfo& info) {
+                  return imGuiKeyIndex(info.imGuiKey);
+              }),
+              "duplicate or out of range ImGuiKey in ENGINE_KEY_LIST");
+
+template <std::size_t Size, typename Index>
+consteval std::array<Key, Size> makeTable(Index index) {
+    std::array<Key, Size> table{};
+    table.fill(Key::not_key);
+    for (const auto& info : s_keys)
+        table[index(info)] = info.key;
+    return table;
+}
+
+inline constexpr auto s_keycodeToKey{ makeTable<s_keycodeTableSize>(
+    [](const KeyInfo& info) { return keycodeIndex(info.keycode); }) };
+
+inline constexpr auto s_imGuiKeyToKey{ makeTable<ImGuiKey_NamedKey_COUNT>(
+    [](const KeyInfo& info) { return imGuiKeyIndex(info.imGuiKey); }) };
+
+constexpr Key fromKeycode(SDL_Keycode keycode) noexcept {
+    const std::size_t index{ keycodeIndex(keycode) };
+    return index < s_keycodeToKey.size() ? s_keycodeToKey[index] : Key::not_key;
+}
+
+constexpr Key fromImGuiKey(ImGuiKey key) noexcept {
+    const std::size_t index{ imGuiKeyIndex(key) };
+    return index < s_imGuiKeyToKey.size() ? s_imGuiKeyToKey[index] : Key::not_key;
+}
+
+constexpr std::string_view toName(Key key) noexcept {
+    const auto index{ static_cast<std::size_t>(key) };
+    return index < s_keys.size() ? s_keys[index].name : std::string_view{};
+}
+
+static_assert(fromKeycode(SDLK_UP) == Key::up_arrow);
+static_assert(fromKeycode(SDLK_SPACE) == Key::space);
+static_assert(fromKeycode(SDLK_KP_ENTER) == Key::numpad_enter);
+static_assert(fromKeycode(0xE0) == Key::not_key);
+static_assert(fromImGuiKey(ImGuiKey_LeftCtrl) == Key::l_control);
+static_assert(fromImGuiKey(ImGuiKey_None) == Key::not_key);
+static_assert(toName(Key::not_key).empty());
+} // namespace key_table
+
+#endif // ENGINE_PREPARE_TO_GAME_KEY_TABLE_HXX
@@ -0,0 +1,201 @@
+#include "logger.hxx"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std::literals;
+
+namespace
+{
+class RecordWriter final
+{
+private:
+    char* m_begin{};
+    char* m_current{};
+    char* m_end{};
+
+public:
+    RecordWriter(char* begin, char* end) noexcept
+        : m_begin{ begin }
+        , m_current{ begin }
+        , m_end{ end } {}
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return static_cast<std::size_t>(m_current - m_begin);
+    }
+
+    void put(char ch) noexcept {
+        if (m_current != m_end) *m_current++ = ch;
+    }
+
+    void put(std::string_view str) noexcept {
+        const auto count{ std::min(str.size(), static_cast<std::size_t>(m_end - m_current)) };
+        m_current = std::copy_n(str.data(), count, m_current);
+    }
+
+    template <typename T>
+    void putNumber(T value) noexcept {
+        const auto [ptr, ec]{ std::to_chars(m_current, m_end, value) };
+        if (ec == std::errc{}) m_current = ptr;
+    }
+
+    void put(const LogField& field) noexcept {
+        put(' ');
+        put(field.key);
+        put('=');
+        switch (field.type) {
+        case LogField::Type::integer: putNumber(field.integer); break;
+        case LogField::Type::unsigned_integer: putNumber(field.unsignedInteger); break;
+        case LogField::Type::floating: putNumber(field.floating); break;
+        case LogField::Type::boolean: put(field.boolean ? "true"sv : "false"sv); break;
+        case LogField::Type::string:
+            if (field.string.empty() || field.string.find(' ') != std::string_view::npos) {
+                put('"');
+                put(field.string);
+                put('"');
+            }
+            else
+                put(field.string);
+            break;
+        }
+    }
+};
+} // namespace
+
+Logger& Logger::getInstance() {
+    static Logger logger{};
+    return logger;
+}
+
+Logger::Logger()
+    : m_thread{ &Logger::run, this } {}
+
+Logger::~Logger() {
+    m_isRunning.store(false, std::memory_order_release);
+    m_pending.fetch_add(1, std::memory_order_release);
+    m_pending.notify_one();
+    m_thread.join();
+    drain();
+}
+
+void Logger::setLevel(LogLevel level) noexcept { m_level.store(level, std::memory_order_relaxed); }
+
+LogLevel Logger::getLevel() const noexcept { return m_level.load(std::memory_order_relaxed); }
+
+bool Logger::isEnabled(LogLevel level) const noexcept {
+    return level != LogLevel::off && level >= m_level.load(std::memory_order_relaxed);
+}
+
+void Logger::log(LogLevel level, std::string_view message, std::initializer_list<LogField> fields) {
+    auto& buffer{ getThreadBuffer() };
+    const auto head{ buffer.head.load(std::memory_order_relaxed) };
+    if (head - buffer.tail.load(std::memory_order_acquire) == ThreadBuffer::s_capacity) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto& record{ buffer.records[head % ThreadBuffer::s_capacity] };
+    record.timestampUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - m_start)
+                             .count();
+    record.threadId = buffer.threadId;
+    record.level = level;
+
+    RecordWriter writer{ record.text.data(), record.text.data() + record.text.size() };
+    writer.put(message);
+    for (const auto& field : fields)
+        writer.put(field);
+    record.textSize = static_cast<std::uint8_t>(writer.size());
+
+    buffer.head.store(head + 1, std::memory_order_release);
+    m_pending.fetch_add(1, std::memory_order_release);
+    m_pending.notify_one();
+}
+
+void Logger::flush() {
+    drain();
+    std::clog.flush();
+}
+
+std::string_view Logger::levelToStr(LogLevel level) noexcept {
+    switch (level) {
+    case LogLevel::trace: return "trace"sv;
+    case LogLevel::debug: return "debug"sv;
+    case LogLevel::info: return "info"sv;
+    case LogLevel::warning: return "warning"sv;
+    case LogLevel::error: return "error"sv;
+    case LogLevel::off: return "off"sv;
+    }
+    return "unknown"sv;
+}
+
+LogLevel Logger::strToLevel(std::string_view str) {
+    for (auto level : { LogLevel::trace,
+                        LogLevel::debug,
+                        LogLevel::info,
+                        LogLevel::warning,
+                        LogLevel::error,
+                        LogLevel::off })
+        if (levelToStr(level) == str) return level;
+
+    throw std::runtime_error{ "Error : strToLevel : unknown log level "s + std::string{ str } };
+}
+
+Logger::ThreadBuffer& Logger::getThreadBuffer() {
+    thread_local ThreadBuffer* threadBuffer{};
+    if (threadBuffer != nullptr) return *threadBuffer;
+
+    std::lock_guard lock{ m_buffersMutex };
+    auto& buffer{ m_buffers.emplace_back(std::make_unique<ThreadBuffer>()) };
+    buffer->threadId = static_cast<std::uint32_t>(m_buffers.size() - 1);
+    threadBuffer = buffer.get();
+    return *threadBuffer;
+}
+
+void Logger::run() {
+    while (m_isRunning.load(std::memory_order_acquire)) {
+        m_pending.wait(0, std::memory_order_relaxed);
+        // The acquire exchange pairs with the producers' release increments, unlike a plain store
+        // it can't drop an increment made after the wait returned without synchronizing with it.
+        m_pending.exchange(0, std::memory_order_acquire);
+        drain();
+    }
+}
+
+void Logger::drain() {
+    std::lock_guard drainLock{ m_drainMutex };
+
+    auto& records{ m_drainRecords };
+    records.clear();
+    std::uint64_t dropped{};
+
+    {
+        std::lock_guard lock{ m_buffersMutex };
+        for (auto& buffer : m_buffers) {
+            const auto tail{ buffer->tail.load(std::memory_order_relaxed) };
+            const auto head{ buffer->head.load(std::memory_order_acquire) };
+            for (auto i{ tail }; i != head; ++i)
+                records.push_back(buffer->records[i % ThreadBuffer::s_capacity]);
+            buffer->tail.store(head, std::memory_order_release);
+            dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::ranges::stable_sort(records, {}, &Record::timestampUs);
+
+    std::array<char, 32> prefix{};
+    for (const auto& record : records) {
+        std::snprintf(prefix.data(),
+                      prefix.size(),
+                      "[%6lld.%06lld] ",
+                      static_cast<long long>(record.timestampUs / 1'000'000),
+                      static_cast<long long>(record.timestampUs % 1'000'000));
+        std::clog << prefix.data() << levelToStr(record.level) << " [t" << record.threadId << "] "
+                  << std::string_view{ record.text.data(), record.textSize } << '\n';
+    }
+
+    if (dropped > 0) std::clog << "logger: dropped " << dropped << " records\n";
+}
@@ -5,7 +5,9 @@
 #include "opengl_check.hxx"
 
 #include <glad/glad.h>
-#include <iostream>
+#include <stdexcept>
+
+#include "logger.hxx"
 
 using namespace std::literals;
 
@@ -14,25 +16,24 @@ void openGLCheck() {
     if (err != GL_NO_ERROR) {
         switch (err) {
         case GL_INVALID_ENUM:
-            std::cerr << "GL_INVALID_ENUM" << std::endl;
+            LOG_ERROR("OpenGL error", { "error", "GL_INVALID_ENUM" });
             break;
         case GL_INVALID_VALUE:
-            std::cerr << "GL_INVALID_VALUE" << std::endl;
+            LOG_ERROR("OpenGL error", { "error", "GL_INVALID_VALUE" });
             break;
         case GL_INVALID_OPERATION:
-            std::cerr << "GL_INVALID_OPERATION" << std::endl;
+            LOG_ERROR("OpenGL error", { "error", "GL_INVALID_OPERATION" });
             break;
         case GL_INVALID_FRAMEBUFFER_OPERATION:
-            std::cerr << "GL_INVALID_FRAMEBUFFER_OPERATION" << std::endl;
+            LOG_ERROR("OpenGL error", { "error", "GL_INVALID_FRAMEBUFFER_OPERATION" });
             break;
         case GL_OUT_OF_MEMORY:
-            std::cerr << "GL_OUT_OF_MEMORY" << std::endl;
+            LOG_ERROR("OpenGL error", { "error", "GL_OUT_OF_MEMORY" });
             break;
         default:
-            std::cerr << "UNKNOWN ERROR" << std::endl;
+            LOG_ERROR("OpenGL error", { "error", "UNKNOWN ERROR" });
             break;
         }
-        std::cerr << __FILE__ << ':' << __LINE__ << '(' << __FUNCTION__ << ')' << std::endl;
         throw std::runtime_error{""s};
     }
 }
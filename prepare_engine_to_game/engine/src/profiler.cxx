@@ -0,0 +1,276 @@
+#include "profiler.hxx"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "logger.hxx"
+
+using namespace std::literals;
+
+Profiler::ScopedZone::ScopedZone(const char* name) noexcept : m_name{ name } {
+    auto& profiler{ getInstance() };
+    if (!profiler.isEnabled()) return;
+
+    ++profiler.getThreadBuffer().depth;
+    m_isActive = true;
+    m_startNs = profiler.now();
+}
+
+Profiler::ScopedZone::~ScopedZone() {
+    if (!m_isActive) return;
+
+    auto& profiler{ getInstance() };
+    const std::int64_t endNs{ profiler.now() };
+    auto& buffer{ profiler.getThreadBuffer() };
+    --buffer.depth;
+    profiler.push(buffer,
+                  Zone{ .name = m_name,
+                        .startNs = m_startNs,
+                        .endNs = endNs,
+                        .threadId = buffer.threadId,
+                        .depth = buffer.depth });
+}
+
+Profiler& Profiler::getInstance() {
+    static Profiler profiler{};
+    return profiler;
+}
+
+void Profiler::setEnabled(bool isEnabled) noexcept {
+    m_isEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+bool Profiler::isEnabled() const noexcept { return m_isEnabled.load(std::memory_order_relaxed); }
+
+std::int64_t Profiler::now() const noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_epoch).count();
+}
+
+Profiler::ThreadBuffer& Profiler::getThreadBuffer() {
+    thread_local ThreadBuffer* threadBuffer{};
+    if (threadBuffer != nullptr) return *threadBuffer;
+
+    std::lock_guard lock{ m_buffersMutex };
+    auto& buffer{ m_buffers.emplace_back(std::make_unique<ThreadBuffer>()) };
+    buffer->threadId = static_cast<std::uint32_t>(m_buffers.size() - 1);
+    threadBuffer = buffer.get();
+    return *threadBuffer;
+}
+
+void Profiler::push(ThreadBuffer& buffer, const Zone& zone) noexcept {
+    const auto head{ buffer.head.load(std::memory_order_relaxed) };
+    if (head - buffer.tail.load(std::memory_order_acquire) == ThreadBuffer::s_capacity) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.zones[head % ThreadBuffer::s_capacity] = zone;
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::newFrame() {
+    const std::int64_t frameEnd{ now() };
+
+    {
+        std::lock_guard lock{ m_buffersMutex };
+        for (auto& buffer : m_buffers) {
+            auto tail{ buffer->tail.load(std::memory_order_relaxed) };
+            const auto head{ buffer->head.load(std::memory_order_acquire) };
+            for (; tail != head; ++tail) {
+                auto zone{ buffer->zones[tail % ThreadBuffer::s_capacity] };
+                zone.name = intern(zone.name);
+                m_currentFrame.zones.push_back(zone);
+            }
+            buffer->tail.store(tail, std::memory_order_release);
+
+            m_droppedZones += buffer->dropped.exchange(0, std::memory_order_relaxed);
+        }
+    }
+
+    m_currentFrame.endNs = frameEnd;
+    if (!m_isPaused) {
+        if (m_frames.size() == s_maxCapturedFrames) m_frames.pop_front();
+        m_frames.push_back(std::move(m_currentFrame));
+    }
+
+    m_currentFrame = Frame{ .startNs = frameEnd };
+}
+
+const std::deque<Profiler::Frame>& Profiler::getFrames() const noexcept { return m_frames; }
+
+void Profiler::setGpuTimingAvailable(bool isAvailable) noexcept {
+    m_isGpuTimingAvailable = isAvailable;
+}
+
+bool Profiler::isGpuTimingAvailable() const noexcept { return m_isGpuTimingAvailable; }
+
+void Profiler::recordZone(const char* name, std::int64_t startNs, std::int64_t endNs) noexcept {
+    if (!isEnabled()) return;
+
+    auto& buffer{ getThreadBuffer() };
+    push(buffer,
+         Zone{ .name = name,
+               .startNs = startNs,
+               .endNs = endNs,
+               .threadId = buffer.threadId,
+               .depth = buffer.depth });
+}
+
+void Profiler::recordGpuZone(const char* name, std::int64_t durationNs) {
+    if (!isEnabled()) return;
+    m_currentFrame.gpuZones.push_back({ .name = intern(name), .durationNs = durationNs });
+}
+
+const char* Profiler::intern(std::string_view name) {
+    auto found{ m_names.find(name) };
+    if (found == m_names.end()) found = m_names.emplace(name).first;
+    return found->c_str();
+}
+
+void Profiler::setWindowVisible(bool isVisible) noexcept { m_isWindowVisible = isVisible; }
+
+bool Profiler::isWindowVisible() const noexcept { return m_isWindowVisible; }
+
+void Profiler::drawImGui() {
+    if (!m_isWindowVisible) return;
+
+    if (!ImGui::Begin("Profiler", &m_isWindowVisible)) {
+        ImGui::End();
+        return;
+    }
+
+    bool isEnabled{ this->isEnabled() };
+    if (ImGui::Checkbox("Enabled", &isEnabled)) setEnabled(isEnabled);
+    ImGui::SameLine();
+    ImGui::Checkbox("Pause", &m_isPaused);
+    ImGui::SameLine();
+    if (ImGui::Button("Dump trace")) {
+        try {
+            dumpChromeTrace("trace.json");
+            LOG_INFO("profiler trace dumped", { "path", "trace.json" });
+        }
+        catch (const std::exception& e) {
+            LOG_ERROR("profiler trace dump failed", { "error", e.what() });
+        }
+    }
+    ImGui::SameLine();
+    ImGui::Text("dropped zones: %llu", static_cast<unsigned long long>(m_droppedZones));
+
+    if (m_frames.empty()) {
+        ImGui::End();
+        return;
+    }
+
+    const auto& frame{ m_frames.back() };
+    const auto frameDuration{ static_cast<float>(frame.endNs - frame.startNs) };
+    ImGui::Text("frame: %.3f ms, zones: %zu", frameDuration * 1e-6f, frame.zones.size());
+
+    std::uint32_t lanes{};
+    std::uint32_t maxDepth{};
+    for (const auto& zone : frame.zones) {
+        lanes = std::max(lanes, zone.threadId + 1);
+        maxDepth = std::max(maxDepth, zone.depth + 1);
+    }
+
+    constexpr float rowHeight{ 18.0f };
+    const float laneHeight{ rowHeight * static_cast<float>(maxDepth) + 4.0f };
+    const ImVec2 origin{ ImGui::GetCursorScreenPos() };
+    const float width{ std::max(ImGui::GetContentRegionAvail().x, 100.0f) };
+    ImGui::InvisibleButton("##timeline", ImVec2{ width, laneHeight * static_cast<float>(lanes) });
+
+    auto* drawList{ ImGui::GetWindowDrawList() };
+    const ImVec2 mouse{ ImGui::GetIO().MousePos };
+    for (const auto& zone : frame.zones) {
+        const float start{ static_cast<float>(std::max(zone.startNs, frame.startNs) -
+                                              frame.startNs) /
+                           frameDuration };
+        const float end{ static_cast<float>(std::min(zone.endNs, frame.endNs) - frame.startNs) /
+                         frameDuration };
+
+        const ImVec2 min{ origin.x + start * width,
+                          origin.y + static_cast<float>(zone.threadId) * laneHeight +
+                              static_cast<float>(zone.depth) * rowHeight };
+        const ImVec2 max{ std::max(origin.x + end * width, min.x + 1.0f), min.y + rowHeight - 1 };
+
+        const auto hash{ std::hash<std::string_view>{}(zone.name) };
+        const ImU32 color{
+            IM_COL32(80 + hash % 120, 80 + (hash >> 8) % 120, 80 + (hash >> 16) % 120, 255)
+        };
+        drawList->AddRectFilled(min, max, color);
+
+        drawList->PushClipRect(min, max, true);
+        drawList->AddText(ImVec2{ min.x + 2, min.y + 2 }, IM_COL32_WHITE, zone.name);
+        drawList->PopClipRect();
+
+        if (mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y)
+            ImGui::SetTooltip("%s\n%.3f ms\nthread %u",
+                              zone.name,
+                              static_cast<double>(zone.endNs - zone.startNs) * 1e-6,
+                              zone.threadId);
+    }
+
+    if (!m_isGpuTimingAvailable)
+        ImGui::TextUnformatted("GPU: unavailable");
+    else {
+        std::int64_t gpuTotal{};
+        for (const auto& gpuZone : frame.gpuZones) {
+            ImGui::Text("GPU %s: %.3f ms",
+                        gpuZone.name,
+                        static_cast<double>(gpuZone.durationNs) * 1e-6);
+            gpuTotal += gpuZone.durationNs;
+        }
+        ImGui::Text("GPU total: %.3f ms", static_cast<double>(gpuTotal) * 1e-6);
+    }
+
+    ImGui::End();
+}
+
+void Profiler::dumpChromeTrace(const std::filesystem::path& path) const {
+    std::ofstream out{ path };
+    if (!out.is_open())
+        throw std::runtime_error{ "Error : Profiler::dumpChromeTrace : bad open file"s };
+
+    const auto writeString{ [&out](std::string_view string) {
+        out << '"';
+        for (const char c : string) {
+            if (c == '"' || c == '\\') out << '\\';
+            out << c;
+        }
+        out << '"';
+    } };
+
+    // Timestamps are in microseconds, fractional part keeps the nanoseconds.
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << s_gpuTrackId
+        << ",\"args\":{\"name\":\"GPU\"}}";
+    for (const auto& frame : m_frames) {
+        for (const auto& zone : frame.zones) {
+            out << ",{\"name\":";
+            writeString(zone.name);
+            out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << zone.threadId
+                << ",\"ts\":" << static_cast<double>(zone.startNs) * 1e-3
+                << ",\"dur\":" << static_cast<double>(zone.endNs - zone.startNs) * 1e-3 << '}';
+        }
+
+        // Only durations are known for the GPU, lay the scopes out one after another on their
+        // own track from the frame start.
+        std::int64_t gpuStart{ frame.startNs };
+        for (const auto& gpuZone : frame.gpuZones) {
+            out << ",{\"name\":";
+            writeString(gpuZone.name);
+            out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << s_gpuTrackId
+                << ",\"ts\":" << static_cast<double>(gpuStart) * 1e-3
+                << ",\"dur\":" << static_cast<double>(gpuZone.durationNs) * 1e-3 << '}';
+            gpuStart += gpuZone.durationNs;
+        }
+    }
+    out << "]}\n";
+}
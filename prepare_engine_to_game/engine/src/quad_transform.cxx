@@ -0,0 +1,288 @@
+#include "quad_transform.hxx"
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#    include <emmintrin.h>
+#    define ENGINE_QUAD_SSE
+#elif defined(__ARM_NEON)
+#    include <arm_neon.h>
+#    define ENGINE_QUAD_NEON
+#endif
+
+namespace
+{
+// The SIMD paths store x, y, texX and texY of a vertex with one 16 byte store.
+static_assert(offsetof(Vertex2, y) == 4 && offsetof(Vertex2, texX) == 8 &&
+              offsetof(Vertex2, texY) == 12);
+static_assert(sizeof(Rectangle) == 4 * sizeof(float));
+
+void writeQuad(Vertex2* vertices, const float* xy, const Rectangle& uv) noexcept {
+    const float uvRight{ uv.xy.x + uv.wh.width };
+    const float uvBottom{ uv.xy.y + uv.wh.height };
+    vertices[0] = { .x = xy[0], .y = xy[1], .texX = uv.xy.x, .texY = uv.xy.y };
+    vertices[1] = { .x = xy[2], .y = xy[3], .texX = uvRight, .texY = uv.xy.y };
+    vertices[2] = { .x = xy[4], .y = xy[5], .texX = uvRight, .texY = uvBottom };
+    vertices[3] = { .x = xy[6], .y = xy[7], .texX = uv.xy.x, .texY = uvBottom };
+}
+
+// Reference implementation and the tail of the SIMD ones, same operation order as the lanes.
+void transformRange(const QuadTransforms& in,
+                    const QuadTexCoords& texCoords,
+                    glm::vec2 worldToNdc,
+                    Vertex2* vertices,
+                    const QuadBounds& bounds,
+                    std::size_t first) noexcept {
+    for (std::size_t i{ first }; i < in.count; ++i) {
+        const float x{ in.positionX[i] };
+        const float y{ in.positionY[i] };
+        const float axisXx{ in.halfWidth[i] * in.rotationCos[i] };
+        const float axisXy{ in.halfWidth[i] * in.rotationSin[i] };
+        const float axisYx{ -(in.halfHeight[i] * in.rotationSin[i]) };
+        const float axisYy{ in.halfHeight[i] * in.rotationCos[i] };
+
+        const float extentX{ std::abs(axisXx) + std::abs(axisYx) };
+        const float extentY{ std::abs(axisXy) + std::abs(axisYy) };
+        bounds.minX[i] = x - extentX;
+        bounds.minY[i] = y - extentY;
+        bounds.maxX[i] = x + extentX;
+        bounds.maxY[i] = y + extentY;
+
+        const float xy[8]{ ((x - axisXx) + axisYx) * worldToNdc.x,
+                           ((y - axisXy) + axisYy) * worldToNdc.y,
+                           ((x + axisXx) + axisYx) * worldToNdc.x,
+                           ((y + axisXy) + axisYy) * worldToNdc.y,
+                           ((x + axisXx) - axisYx) * worldToNdc.x,
+                           ((y + axisXy) - axisYy) * worldToNdc.y,
+                           ((x - axisXx) - axisYx) * worldToNdc.x,
+                           ((y - axisXy) - axisYy) * worldToNdc.y };
+        writeQuad(vertices + i * 4, xy, texCoords.uvs[texCoords.uvIndices[i]]);
+    }
+}
+
+#ifdef ENGINE_QUAD_SSE
+// Corners of 4 quads as lanes: x and y of top left, top right, bottom right, bottom left.
+using CornersSse = __m128[8];
+
+// Transposes the lanes into vertices, vertex corner of quad first + lane.
+void storeCornerSse(Vertex2* vertices, __m128 x, __m128 y, __m128 texX, __m128 texY) noexcept {
+    _MM_TRANSPOSE4_PS(x, y, texX, texY);
+    _mm_storeu_ps(&vertices[0].x, x);
+    _mm_storeu_ps(&vertices[4].x, y);
+    _mm_storeu_ps(&vertices[8].x, texX);
+    _mm_storeu_ps(&vertices[12].x, texY);
+    vertices[0].rgba = vertices[4].rgba = vertices[8].rgba = vertices[12].rgba = 0;
+}
+
+void writeQuadsSse(const CornersSse& corners,
+                   std::size_t first,
+                   const QuadTexCoords& texCoords,
+                   Vertex2* vertices) noexcept {
+    const auto* indices{ texCoords.uvIndices + first };
+    __m128 uvLeft{ _mm_loadu_ps(&texCoords.uvs[indices[0]].xy.x) };
+    __m128 uvTop{ _mm_loadu_ps(&texCoords.uvs[indices[1]].xy.x) };
+    __m128 uvWidth{ _mm_loadu_ps(&texCoords.uvs[indices[2]].xy.x) };
+    __m128 uvHeight{ _mm_loadu_ps(&texCoords.uvs[indices[3]].xy.x) };
+    _MM_TRANSPOSE4_PS(uvLeft, uvTop, uvWidth, uvHeight);
+    const __m128 uvRight{ _mm_add_ps(uvLeft, uvWidth) };
+    const __m128 uvBottom{ _mm_add_ps(uvTop, uvHeight) };
+
+    auto* quad{ vertices + first * 4 };
+    storeCornerSse(quad + 0, corners[0], corners[1], uvLeft, uvTop);
+    storeCornerSse(quad + 1, corners[2], corners[3], uvRight, uvTop);
+    storeCornerSse(quad + 2, corners[4], corners[5], uvRight, uvBottom);
+    storeCornerSse(quad + 3, corners[6], corners[7], uvLeft, uvBottom);
+}
+
+void transformSse(const QuadTransforms& in,
+                  const QuadTexCoords& texCoords,
+                  glm::vec2 worldToNdc,
+                  Vertex2* vertices,
+                  const QuadBounds& bounds) noexcept {
+    constexpr std::size_t width{ 4 };
+    const __m128 signMask{ _mm_set1_ps(-0.0f) };
+    const __m128 ndcX{ _mm_set1_ps(worldToNdc.x) };
+    const __m128 ndcY{ _mm_set1_ps(worldToNdc.y) };
+
+    std::size_t i{};
+    for (; i + width <= in.count; i += width) {
+        const __m128 x{ _mm_loadu_ps(in.positionX + i) };
+        const __m128 y{ _mm_loadu_ps(in.positionY + i) };
+        const __m128 sin{ _mm_loadu_ps(in.rotationSin + i) };
+        const __m128 cos{ _mm_loadu_ps(in.rotationCos + i) };
+        const __m128 halfWidth{ _mm_loadu_ps(in.halfWidth + i) };
+        const __m128 halfHeight{ _mm_loadu_ps(in.halfHeight + i) };
+
+        const __m128 axisXx{ _mm_mul_ps(halfWidth, cos) };
+        const __m128 axisXy{ _mm_mul_ps(halfWidth, sin) };
+        const __m128 axisYx{ _mm_xor_ps(_mm_mul_ps(halfHeight, sin), signMask) };
+        const __m128 axisYy{ _mm_mul_ps(halfHeight, cos) };
+
+        const __m128 extentX{ _mm_add_ps(_mm_andnot_ps(signMask, axisXx),
+                                         _mm_andnot_ps(signMask, axisYx)) };
+        const __m128 extentY{ _mm_add_ps(_mm_andnot_ps(signMask, axisXy),
+                                         _mm_andnot_ps(signMask, axisYy)) };
+        _mm_storeu_ps(bounds.minX + i, _mm_sub_ps(x, extentX));
+        _mm_storeu_ps(bounds.minY + i, _mm_sub_ps(y, extentY));
+        _mm_storeu_ps(bounds.maxX + i, _mm_add_ps(x, extentX));
+        _mm_storeu_ps(bounds.maxY + i, _mm_add_ps(y, extentY));
+
+        const __m128 left{ _mm_sub_ps(x, axisXx) };
+        const __m128 right{ _mm_add_ps(x, axisXx) };
+        const __m128 leftY{ _mm_sub_ps(y, axisXy) };
+        const __m128 rightY{ _mm_add_ps(y, axisXy) };
+        const CornersSse corners{ _mm_mul_ps(_mm_add_ps(left, axisYx), ndcX),
+                                  _mm_mul_ps(_mm_add_ps(leftY, axisYy), ndcY),
+                                  _mm_mul_ps(_mm_add_ps(right, axisYx), ndcX),
+                                  _mm_mul_ps(_mm_add_ps(rightY, axisYy), ndcY),
+                                  _mm_mul_ps(_mm_sub_ps(right, axisYx), ndcX),
+                                  _mm_mul_ps(_mm_sub_ps(rightY, axisYy), ndcY),
+                                  _mm_mul_ps(_mm_sub_ps(left, axisYx), ndcX),
+                                  _mm_mul_ps(_mm_sub_ps(leftY, axisYy), ndcY) };
+        writeQuadsSse(corners, i, texCoords, vertices);
+    }
+    transformRange(in, texCoords, worldToNdc, vertices, bounds, i);
+}
+#endif
+
+#ifdef ENGINE_QUAD_NEON
+void transpose4(float32x4_t& a, float32x4_t& b, float32x4_t& c, float32x4_t& d) noexcept {
+    const float32x4x2_t ac{ vzipq_f32(a, c) };
+    const float32x4x2_t bd{ vzipq_f32(b, d) };
+    const float32x4x2_t low{ vzipq_f32(ac.val[0], bd.val[0]) };
+    const float32x4x2_t high{ vzipq_f32(ac.val[1], bd.val[1]) };
+    a = low.val[0];
+    b = low.val[1];
+    c = high.val[0];
+    d = high.val[1];
+}
+
+void storeCornerNeon(Vertex2* vertices,
+                     float32x4_t x,
+                     float32x4_t y,
+                     float32x4_t texX,
+                     float32x4_t texY) noexcept {
+    transpose4(x, y, texX, texY);
+    vst1q_f32(&vertices[0].x, x);
+    vst1q_f32(&vertices[4].x, y);
+    vst1q_f32(&vertices[8].x, texX);
+    vst1q_f32(&vertices[12].x, texY);
+    vertices[0].rgba = vertices[4].rgba = vertices[8].rgba = vertices[12].rgba = 0;
+}
+
+void transformNeon(const QuadTransforms& in,
+                   const QuadTexCoords& texCoords,
+                   glm::vec2 worldToNdc,
+                   Vertex2* vertices,
+                   const QuadBounds& bounds) noexcept {
+    constexpr std::size_t width{ 4 };
+    const float32x4_t ndcX{ vdupq_n_f32(worldToNdc.x) };
+    const float32x4_t ndcY{ vdupq_n_f32(worldToNdc.y) };
+
+    std::size_t i{};
+    for (; i + width <= in.count; i += width) {
+        const float32x4_t x{ vld1q_f32(in.positionX + i) };
+        const float32x4_t y{ vld1q_f32(in.positionY + i) };
+        const float32x4_t sin{ vld1q_f32(in.rotationSin + i) };
+        const float32x4_t cos{ vld1q_f32(in.rotationCos + i) };
+        const float32x4_t halfWidth{ vld1q_f32(in.halfWidth + i) };
+        const float32x4_t halfHeight{ vld1q_f32(in.halfHeight + i) };
+
+        const float32x4_t axisXx{ vmulq_f32(halfWidth, cos) };
+        const float32x4_t axisXy{ vmulq_f32(halfWidth, sin) };
+        const float32x4_t axisYx{ vnegq_f32(vmulq_f32(halfHeight, sin)) };
+        const float32x4_t axisYy{ vmulq_f32(halfHeight, cos) };
+
+        const float32x4_t extentX{ vaddq_f32(vabsq_f32(axisXx), vabsq_f32(axisYx)) };
+        const float32x4_t extentY{ vaddq_f32(vabsq_f32(axisXy), vabsq_f32(axisYy)) };
+        vst1q_f32(bounds.minX + i, vsubq_f32(x, extentX));
+        vst1q_f32(bounds.minY + i, vsubq_f32(y, extentY));
+        vst1q_f32(bounds.maxX + i, vaddq_f32(x, extentX));
+        vst1q_f32(bounds.maxY + i, vaddq_f32(y, extentY));
+
+        const float32x4_t left{ vsubq_f32(x, axisXx) };
+        const float32x4_t right{ vaddq_f32(x, axisXx) };
+        const float32x4_t leftY{ vsubq_f32(y, axisXy) };
+        const float32x4_t rightY{ vaddq_f32(y, axisXy) };
+        const auto* indices{ texCoords.uvIndices + i };
+        float32x4_t uvLeft{ vld1q_f32(&texCoords.uvs[indices[0]].xy.x) };
+        float32x4_t uvTop{ vld1q_f32(&texCoords.uvs[indices[1]].xy.x) };
+        float32x4_t uvWidth{ vld1q_f32(&texCoords.uvs[indices[2]].xy.x) };
+        float32x4_t uvHeight{ vld1q_f32(&texCoords.uvs[indices[3]].xy.x) };
+        transpose4(uvLeft, uvTop, uvWidth, uvHeight);
+        const float32x4_t uvRight{ vaddq_f32(uvLeft, uvWidth) };
+        const float32x4_t uvBottom{ vaddq_f32(uvTop, uvHeight) };
+
+        auto* quad{ vertices + i * 4 };
+        storeCornerNeon(quad + 0,
+                        vmulq_f32(vaddq_f32(left, axisYx), ndcX),
+                        vmulq_f32(vaddq_f32(leftY, axisYy), ndcY),
+                        uvLeft,
+                        uvTop);
+        storeCornerNeon(quad + 1,
+                        vmulq_f32(vaddq_f32(right, axisYx), ndcX),
+                        vmulq_f32(vaddq_f32(rightY, axisYy), ndcY),
+                        uvRight,
+                        uvTop);
+        storeCornerNeon(quad + 2,
+                        vmulq_f32(vsubq_f32(right, axisYx), ndcX),
+                        vmulq_f32(vsubq_f32(rightY, axisYy), ndcY),
+                        uvRight,
+                        uvBottom);
+        storeCornerNeon(quad + 3,
+                        vmulq_f32(vsubq_f32(left, axisYx), ndcX),
+                        vmulq_f32(vsubq_f32(leftY, axisYy), ndcY),
+                        uvLeft,
+                        uvBottom);
+    }
+    transformRange(in, texCoords, worldToNdc, vertices, bounds, i);
+}
+#endif
+} // namespace
+
+void transformQuads(const QuadTransforms& transforms,
+                    const QuadTexCoords& texCoords,
+                    glm::vec2 worldToNdc,
+                    Vertex2* vertices,
+                    const QuadBounds& bounds) noexcept {
+#if defined(ENGINE_QUAD_SSE)
+    transformSse(transforms, texCoords, worldToNdc, vertices, bounds);
+#elif defined(ENGINE_QUAD_NEON)
+    transformNeon(transforms, texCoords, worldToNdc, vertices, bounds);
+#else
+    transformRange(transforms, texCoords, worldToNdc, vertices, bounds, 0);
+#endif
+}
+
+void transformQuadsScalar(const QuadTransforms& transforms,
+                          const QuadTexCoords& texCoords,
+                          glm::vec2 worldToNdc,
+                          Vertex2* vertices,
+                          const QuadBounds& bounds) noexcept {
+    transformRange(transforms, texCoords, worldToNdc, vertices, bounds, 0);
+}
+
+void computeQuadBounds(const QuadTransforms& in, const QuadBounds& bounds) noexcept {
+    // No stores but the bounds, the compiler vectorizes this loop on its own.
+    for (std::size_t i{}; i < in.count; ++i) {
+        const float extentX{ std::abs(in.halfWidth[i] * in.rotationCos[i]) +
+                             std::abs(in.halfHeight[i] * in.rotationSin[i]) };
+        const float extentY{ std::abs(in.halfWidth[i] * in.rotationSin[i]) +
+                             std::abs(in.halfHeight[i] * in.rotationCos[i]) };
+        bounds.minX[i] = in.positionX[i] - extentX;
+        bounds.minY[i] = in.positionY[i] - extentY;
+        bounds.maxX[i] = in.positionX[i] + extentX;
+        bounds.maxY[i] = in.positionY[i] + extentY;
+    }
+}
+
+std::string_view getQuadTransformIsa() noexcept {
+#if defined(ENGINE_QUAD_SSE)
+    return "sse2";
+#elif defined(ENGINE_QUAD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,64 @@
+#ifndef ENGINE_PREPARE_TO_GAME_QUAD_TRANSFORM_HXX
+#define ENGINE_PREPARE_TO_GAME_QUAD_TRANSFORM_HXX
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "buffer.hxx"
+#include "structures.hxx"
+
+// Transform of a batch of quads in structure-of-arrays form. Every array holds count values,
+// half sizes are already scaled.
+struct QuadTransforms
+{
+    const float* positionX{};
+    const float* positionY{};
+    const float* rotationSin{};
+    const float* rotationCos{};
+    const float* halfWidth{};
+    const float* halfHeight{};
+    std::size_t count{};
+};
+
+// Axis aligned bounds of the rotated quads, in the units of the transforms.
+struct QuadBounds
+{
+    float* minX{};
+    float* minY{};
+    float* maxX{};
+    float* maxY{};
+};
+
+// Texture rectangle of every quad, uvIndices selects one of uvs per quad.
+struct QuadTexCoords
+{
+    const Rectangle* uvs{};
+    const std::uint16_t* uvIndices{};
+};
+
+// Writes 4 vertices per quad (top left, top right, bottom right, bottom left) with positions
+// multiplied by worldToNdc, and the bounds of the quads. Runs 4 quads at a time with SSE2 or NEON,
+// the rest one by one.
+void transformQuads(const QuadTransforms& transforms,
+                    const QuadTexCoords& texCoords,
+                    glm::vec2 worldToNdc,
+                    Vertex2* vertices,
+                    const QuadBounds& bounds) noexcept;
+
+// The same without SIMD, the reference for tests and benchmarks.
+void transformQuadsScalar(const QuadTransforms& transforms,
+                          const QuadTexCoords& texCoords,
+                          glm::vec2 worldToNdc,
+                          Vertex2* vertices,
+                          const QuadBounds& bounds) noexcept;
+
+// Only the bounds, for collision queries between draws.
+void computeQuadBounds(const QuadTransforms& transforms, const QuadBounds& bounds) noexcept;
+
+// Name of the implementation transformQuads runs, for logs and benchmarks.
+std::string_view getQuadTransformIsa() noexcept;
+
+#endif // ENGINE_PREPARE_TO_GAME_QUAD_TRANSFORM_HXX
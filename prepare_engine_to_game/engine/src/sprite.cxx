@@ -5,7 +5,8 @@
 Sprite::Sprite(Size size)
     : m_size{ size }
     , m_windowWidth{ getEngineInstance()->getWindowSize().width }
-    , m_windowHeight{ getEngineInstance()->getWindowSize().height } {
+    , m_windowHeight{ getEngineInstance()->getWindowSize().height }
+    , m_metricsVersion{ getEngineInstance()->getDisplayMetrics().version } {
     initialize();
 }
 
@@ -13,7 +14,8 @@ Sprite::Sprite(const fs::path& texturePath)
     : m_hasTexture{ true }
     , m_texture{ new Texture{} }
     , m_windowWidth{ getEngineInstance()->getWindowSize().width }
-    , m_windowHeight{ getEngineInstance()->getWindowSize().height } {
+    , m_windowHeight{ getEngineInstance()->getWindowSize().height }
+    , m_metricsVersion{ getEngineInstance()->getDisplayMetrics().version } {
     m_texture->load(texturePath);
     m_size.width = m_texture->getWidth();
     m_size.height = m_texture->getHeight();
@@ -25,7 +27,8 @@ Sprite::Sprite(const fs::path& texturePath, Size size)
     , m_hasTexture{ true }
     , m_texture{ new Texture{} }
     , m_windowWidth{ getEngineInstance()->getWindowSize().width }
-    , m_windowHeight{ getEngineInstance()->getWindowSize().height } {
+    , m_windowHeight{ getEngineInstance()->getWindowSize().height }
+    , m_metricsVersion{ getEngineInstance()->getDisplayMetrics().version } {
     m_texture->load(texturePath);
     initialize();
 }
@@ -33,60 +36,56 @@ Sprite::Sprite(const fs::path& texturePath, Size size)
 void Sprite::checkAspect(Size size) {
     m_aspectMatrix[0][0] = size.width / m_windowWidth;
     m_aspectMatrix[1][1] = size.height / m_windowHeight;
+    m_isDirty = true;
 }
 
-glm::mat3 Sprite::getResultMatrix() const noexcept {
-    auto mat{ m_scaleMatrix };
-    mat[1][1] *= m_aspectMatrix[1][1];
-    mat[0][0] *= m_aspectMatrix[0][0];
-    auto resultMatrix{ m_moveMatrix * mat * m_rotationMatrix };
-    return resultMatrix;
+const glm::mat3& Sprite::getResultMatrix() const noexcept {
+    if (m_isDirty) updateCache();
+    return m_resultMatrix;
 }
 
 Position Sprite::getPosition() const noexcept {
-    auto resultVec{ m_moveMatrix * glm::vec3(m_position.x, m_position.y, 1.0) };
-    float x = resultVec.x * (getEngineInstance()->getWindowSize().width / 2.0f);
-    float y = resultVec.y * (getEngineInstance()->getWindowSize().height / 2.0f);
-
-    return { x, y };
+    syncCache();
+    return m_worldPosition;
 }
 
 void Sprite::setPosition(Position position) {
-    m_moveMatrix[2][0] = position.x / (getEngineInstance()->getWindowSize().width / 2.0f);
-    m_moveMatrix[2][1] = position.y / (getEngineInstance()->getWindowSize().height / 2.0f);
+    const auto& toNdc{ getEngineInstance()->getDisplayMetrics().windowToNdc };
+    m_moveMatrix[2][0] = position.x * toNdc.x;
+    m_moveMatrix[2][1] = position.y * toNdc.y;
+    m_isDirty = true;
 }
 
-Size Sprite::getSize() const noexcept {
-    auto scale{ m_scaleMatrix };
-    scale[0][0] *= m_aspectMatrix[0][0];
-    scale[1][1] *= m_aspectMatrix[1][1];
-    auto transformed{ m_rotationMatrix * scale * glm::vec3(m_size.width, m_size.height, 1.0f) };
-    return { std::abs(transformed.x), std::abs(transformed.y) };
-}
+Size Sprite::getSize() const noexcept { return getRectangle().wh; }
 
 void Sprite::setScale(Scale scale) {
     m_scale = scale;
     m_scaleMatrix[0][0] = scale.x;
     m_scaleMatrix[1][1] = scale.y;
+    m_isDirty = true;
 }
 
 Scale Sprite::getScale() const noexcept { return m_scale; }
 
 void Sprite::setRotate(float angle) {
     m_rotationAngle = angle;
-    m_rotationMatrix[0][0] = std::cos(m_rotationAngle.getInRadians());
-    m_rotationMatrix[0][1] = std::sin(m_rotationAngle.getInRadians());
-    m_rotationMatrix[1][0] = -std::sin(m_rotationAngle.getInRadians());
-    m_rotationMatrix[1][1] = std::cos(m_rotationAngle.getInRadians());
+    // Adjacent sin and cos of the same argument are fused into a single sincos call.
+    const float radians{ m_rotationAngle.getInRadians() };
+    const float sin{ std::sin(radians) };
+    const float cos{ std::cos(radians) };
+
+    m_rotationMatrix[0][0] = cos;
+    m_rotationMatrix[0][1] = sin;
+    m_rotationMatrix[1][0] = -sin;
+    m_rotationMatrix[1][1] = cos;
 
     updateWindowSize();
     checkAspect(s_originalWindowSize);
 
-    auto aspectWH{ s_originalWindowSize.width / s_originalWindowSize.height };
-    m_aspectMatrix[1][1] *=
-        1 + std::abs((aspectWH - 1) * pow(std::sin(m_rotationAngle.getInRadians()), 2));
-    m_aspectMatrix[0][0] /=
-        1 + std::abs((aspectWH - 1) * pow(std::sin(m_rotationAngle.getInRadians()), 2));
+    const auto aspectWH{ s_originalWindowSize.width / s_originalWindowSize.height };
+    const auto aspectCorrection{ 1 + std::abs((aspectWH - 1) * sin * sin) };
+    m_aspectMatrix[1][1] *= aspectCorrection;
+    m_aspectMatrix[0][0] /= aspectCorrection;
 }
 
 Angle Sprite::getRotate() const noexcept { return m_rotationAngle; }
@@ -98,14 +97,43 @@ const std::vector<uint16_t>& Sprite::getIndices() const noexcept { return m_indi
 const Texture& Sprite::getTexture() const noexcept { return *m_texture; }
 
 void Sprite::updateWindowSize() {
-    m_windowWidth = getEngineInstance()->getWindowSize().width;
-    m_windowHeight = getEngineInstance()->getWindowSize().height;
+    const auto& metrics{ getEngineInstance()->getDisplayMetrics() };
+    if (metrics.version == m_metricsVersion) return;
+
+    m_windowWidth = metrics.windowSize.width;
+    m_windowHeight = metrics.windowSize.height;
+    m_metricsVersion = metrics.version;
+    m_isDirty = true;
+}
+
+const Rectangle& Sprite::getRectangle() const noexcept {
+    syncCache();
+    return m_rectangle;
+}
+
+void Sprite::syncCache() const noexcept {
+    if (m_isDirty || m_cacheVersion != getEngineInstance()->getDisplayMetrics().version)
+        updateCache();
 }
 
-Rectangle Sprite::getRectangle() const noexcept {
-    return Rectangle{ .xy = { getPosition().x - getSize().width / 2.0f,
-                              getPosition().y - getSize().height / 2.0f },
-                      .wh = { getSize() } };
+void Sprite::updateCache() const noexcept {
+    auto scale{ m_scaleMatrix };
+    scale[0][0] *= m_aspectMatrix[0][0];
+    scale[1][1] *= m_aspectMatrix[1][1];
+    const auto scaleRotation{ scale * m_rotationMatrix };
+    m_resultMatrix = m_moveMatrix * scaleRotation;
+
+    const auto& metrics{ getEngineInstance()->getDisplayMetrics() };
+    const auto center{ m_moveMatrix * glm::vec3(m_position.x, m_position.y, 1.0f) };
+    const auto extent{ m_rotationMatrix * scale * glm::vec3(m_size.width, m_size.height, 1.0f) };
+    const Size size{ std::abs(extent.x), std::abs(extent.y) };
+    m_worldPosition = { center.x / metrics.windowToNdc.x, center.y / metrics.windowToNdc.y };
+    m_rectangle = { .xy = { m_worldPosition.x - size.width / 2.0f,
+                            m_worldPosition.y - size.height / 2.0f },
+                    .wh = size };
+
+    m_cacheVersion = metrics.version;
+    m_isDirty = false;
 }
 
 Sprite::~Sprite() {
@@ -130,8 +158,8 @@ void Sprite::initialize() {
     m_rotationMatrix[2][2] = 1.0f;
 
     if (s_originalWindowSize.width == 0 || s_originalWindowSize.height == 0) {
-        s_originalWindowSize.width = getEngineInstance()->getWindowSize().width;
-        s_originalWindowSize.height = getEngineInstance()->getWindowSize().height;
+        s_originalWindowSize.width = static_cast<float>(m_windowWidth);
+        s_originalWindowSize.height = static_cast<float>(m_windowHeight);
     }
 
     m_vertices.push_back({ (-m_size.width / 2) / (s_originalWindowSize.width / 2.0f),
@@ -159,6 +187,7 @@ void Sprite::initialize() {
                            0 });
 
     m_indices = { 0, 1, 2, 0, 2, 3 };
+    m_isDirty = true;
 }
 
 void Sprite::setTexture(Texture& texture) {
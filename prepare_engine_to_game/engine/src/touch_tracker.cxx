@@ -0,0 +1,161 @@
+#include "touch_tracker.hxx"
+
+#include <cmath>
+#include <utility>
+
+void TouchTracker::setWindowSize(float width, float height) noexcept {
+    m_width = width;
+    m_height = height;
+}
+
+std::optional<Event> TouchTracker::handle(const SDL_Event& sdlEvent) {
+    const auto& finger{ sdlEvent.tfinger };
+    const Position pos{ finger.x * m_width, (1.0f - finger.y) * m_height };
+
+    Event event{};
+    switch (sdlEvent.type) {
+    case SDL_EVENT_FINGER_DOWN: {
+        Finger* slot{};
+        for (auto& candidate : m_fingers)
+            if (!candidate.isDown) {
+                slot = &candidate;
+                break;
+            }
+        if (slot == nullptr) return std::nullopt;
+
+        *slot = { .sdlId = finger.fingerId,
+                  .start = pos,
+                  .pos = pos,
+                  .downNs = sdlEvent.common.timestamp,
+                  .isDown = true,
+                  .isTapCandidate = m_downCount == 0 };
+        ++m_downCount;
+
+        // A second finger turns the touch into a pinch, neither finger can tap or drag anymore.
+        if (m_downCount == 2) {
+            for (auto& other : m_fingers) {
+                if (other.isDragging) {
+                    Event drag{};
+                    drag.type = Event::Type::gesture_drag;
+                    drag.gesture.pos = other.pos;
+                    m_gesture = drag;
+                }
+                other.isTapCandidate = false;
+                other.isDragging = false;
+            }
+            m_pinchDistance = getPinchDistance();
+        }
+
+        event.type = Event::Type::touch_down;
+        event.touch.id = static_cast<std::size_t>(slot - m_fingers.data());
+        event.touch.pos = pos;
+        return event;
+    }
+
+    case SDL_EVENT_FINGER_MOTION: {
+        Finger* slot{ find(finger.fingerId) };
+        if (slot == nullptr) return std::nullopt;
+
+        slot->pos = pos;
+        const float dx{ pos.x - slot->start.x };
+        const float dy{ pos.y - slot->start.y };
+        if (slot->isTapCandidate && std::hypot(dx, dy) > s_tapSlop) {
+            slot->isTapCandidate = false;
+            slot->isDragging = true;
+        }
+
+        if (slot->isDragging) {
+            Event drag{};
+            drag.type = Event::Type::gesture_drag;
+            drag.gesture.pos = pos;
+            drag.gesture.dx = dx;
+            drag.gesture.dy = dy;
+            m_gesture = drag;
+        }
+
+        if (m_downCount == 2 && m_pinchDistance > 0.0f) {
+            const float distance{ getPinchDistance() };
+            const float scale{ distance / m_pinchDistance };
+            if (std::abs(scale - 1.0f) >= s_pinchMinStep) {
+                Event pinch{};
+                pinch.type = Event::Type::gesture_pinch;
+                pinch.gesture.pos = getPinchCenter();
+                pinch.gesture.scale = scale;
+                m_gesture = pinch;
+                m_pinchDistance = distance;
+            }
+        }
+
+        event.type = Event::Type::touch_motion;
+        event.touch.id = static_cast<std::size_t>(slot - m_fingers.data());
+        event.touch.pos = pos;
+        event.touch.dx = dx;
+        event.touch.dy = dy;
+        return event;
+    }
+
+    case SDL_EVENT_FINGER_UP: {
+        Finger* slot{ find(finger.fingerId) };
+        if (slot == nullptr) return std::nullopt;
+
+        if (slot->isTapCandidate && sdlEvent.common.timestamp - slot->downNs <= s_tapMaxNs) {
+            Event tap{};
+            tap.type = Event::Type::gesture_tap;
+            tap.gesture.pos = pos;
+            tap.gesture.scale = 1.0f;
+            m_gesture = tap;
+        }
+
+        slot->isDown = false;
+        --m_downCount;
+        if (m_downCount < 2) m_pinchDistance = 0.0f;
+
+        event.type = Event::Type::touch_up;
+        event.touch.id = static_cast<std::size_t>(slot - m_fingers.data());
+        event.touch.pos = pos;
+        return event;
+    }
+
+    default:
+        return std::nullopt;
+    }
+}
+
+std::optional<Event> TouchTracker::pollGesture() noexcept {
+    return std::exchange(m_gesture, std::nullopt);
+}
+
+void TouchTracker::reset() noexcept {
+    m_fingers = {};
+    m_downCount = 0;
+    m_pinchDistance = 0.0f;
+    m_gesture.reset();
+}
+
+TouchTracker::Finger* TouchTracker::find(SDL_FingerID sdlId) noexcept {
+    for (auto& finger : m_fingers)
+        if (finger.isDown && finger.sdlId == sdlId) return &finger;
+    return nullptr;
+}
+
+float TouchTracker::getPinchDistance() const noexcept {
+    const Finger* first{};
+    for (const auto& finger : m_fingers) {
+        if (!finger.isDown) continue;
+        if (first == nullptr)
+            first = &finger;
+        else
+            return std::hypot(finger.pos.x - first->pos.x, finger.pos.y - first->pos.y);
+    }
+    return 0.0f;
+}
+
+Position TouchTracker::getPinchCenter() const noexcept {
+    Position center{};
+    for (const auto& finger : m_fingers)
+        if (finger.isDown) {
+            center.x += finger.pos.x / 2.0f;
+            center.y += finger.pos.y / 2.0f;
+        }
+    return center;
+}
@@ -0,0 +1,65 @@
+#ifndef ENGINE_PREPARE_TO_GAME_TOUCH_TRACKER_HXX
+#define ENGINE_PREPARE_TO_GAME_TOUCH_TRACKER_HXX
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "engine.hxx"
+
+// Fingers in a fixed array and gesture recognition on top of them. Touch events get the slot
+// of the finger as id, so the first finger down is always 0 while it stays down. Positions are
+// in window coordinates with y going up, like the rest of the input.
+//
+// A lone finger that moves past the tap slop drags: every motion sends a drag with its offset
+// from the start. A second finger ends the drag with a zero offset and starts a pinch.
+class TouchTracker final
+{
+public:
+    static constexpr std::size_t s_maxFingers{ InputState::s_maxTouches };
+    static constexpr float s_tapSlop{ 10.0f }; // px a tap may move before it becomes a drag
+    static constexpr std::uint64_t s_tapMaxNs{ 250'000'000 };
+    static constexpr float s_pinchMinStep{ 0.01f }; // smaller scale changes are accumulated
+
+private:
+    struct Finger
+    {
+        SDL_FingerID sdlId{};
+        Position start{};
+        Position pos{};
+        std::uint64_t downNs{};
+        bool isDown{};
+        bool isTapCandidate{};
+        bool isDragging{};
+    };
+
+    std::array<Finger, s_maxFingers> m_fingers{};
+    std::size_t m_downCount{};
+    float m_width{};
+    float m_height{};
+
+    float m_pinchDistance{}; // distance at the last pinch event, 0 while not pinching
+    std::optional<Event> m_gesture{};
+
+public:
+    // Cached by the engine on window resize, the events don't query SDL.
+    void setWindowSize(float width, float height) noexcept;
+
+    // Touch event for a finger SDL event, nullopt for other events and fingers over the limit.
+    // A recognized gesture is queued for pollGesture.
+    std::optional<Event> handle(const SDL_Event& sdlEvent);
+
+    std::optional<Event> pollGesture() noexcept;
+
+    // Lifts all fingers, e.g. when the app goes to background.
+    void reset() noexcept;
+
+private:
+    Finger* find(SDL_FingerID sdlId) noexcept;
+    [[nodiscard]] float getPinchDistance() const noexcept;
+    [[nodiscard]] Position getPinchCenter() const noexcept;
+};
+
+#endif // ENGINE_PREPARE_TO_GAME_TOUCH_TRACKER_HXX
@@ -12,13 +12,13 @@ glm::mat3 View::getViewMatrix() const {
 }
 
 void View::setPosition(Position position) {
-    m_position = { position.x / (getEngineInstance()->getWindowSize().width / 2.0f),
-                   position.y / (getEngineInstance()->getWindowSize().height / 2.0f) };
+    const auto& toNdc{ getEngineInstance()->getDisplayMetrics().windowToNdc };
+    m_position = { position.x * toNdc.x, position.y * toNdc.y };
 }
 
 Position View::getPosition() const noexcept {
-    return { m_position.x * (getEngineInstance()->getWindowSize().width / 2.0f),
-             m_position.y * (getEngineInstance()->getWindowSize().height / 2.0f) };
+    const auto& toNdc{ getEngineInstance()->getDisplayMetrics().windowToNdc };
+    return { m_position.x / toNdc.x, m_position.y / toNdc.y };
 }
 
 void View::setScale(float scale) { m_scale = scale; }
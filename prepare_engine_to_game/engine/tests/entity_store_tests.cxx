@@ -0,0 +1,43 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+
+#include "entity_store.hxx"
+
+TEST_CASE("stale entity handles stay dead when the slot is reused", "[entity_store]") {
+    EntityStore store{};
+    const auto region{ store.addRegion({ .size = { 1.0f, 1.0f } }) };
+
+    const auto first{ store.create({ 1.0f, 2.0f }, region) };
+    const auto second{ store.create({ 3.0f, 4.0f }, region) };
+    store.destroy(first);
+
+    // The new entity takes the slot of the first one.
+    const auto reused{ store.create({ 5.0f, 6.0f }, region) };
+    REQUIRE((reused & EntityStore::s_indexMask) == (first & EntityStore::s_indexMask));
+    REQUIRE(reused != first);
+    REQUIRE_FALSE(store.isAlive(first));
+    REQUIRE(store.isAlive(reused));
+    REQUIRE(store.isAlive(second));
+
+    REQUIRE_THROWS_AS(store.getPosition(first), std::runtime_error);
+    REQUIRE_THROWS_AS(store.destroy(first), std::runtime_error);
+    REQUIRE(store.getPosition(reused).x == 5.0f);
+    REQUIRE(store.getPosition(second).x == 3.0f);
+    REQUIRE(store.size() == 2);
+}
+
+TEST_CASE("clear kills every handle", "[entity_store]") {
+    EntityStore store{};
+    const auto region{ store.addRegion({ .size = { 1.0f, 1.0f } }) };
+
+    const auto entity{ store.create({}, region) };
+    store.clear();
+    REQUIRE(store.empty());
+    REQUIRE_FALSE(store.isAlive(entity));
+
+    const auto next{ store.create({}, region) };
+    REQUIRE(next != entity);
+    REQUIRE(store.isAlive(next));
+    REQUIRE_FALSE(store.isAlive(EntityStore::s_invalidEntity));
+}
@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <engine.hxx>
 #include <memory>
+#include <profiler.hxx>
 #include <stdexcept>
 
 #include "config.hxx"
@@ -19,7 +21,9 @@ class PirateGame final : public IGame
 {
 private:
     inline static constexpr Size s_originalWindowSize{ 800, 600 };
-    inline static constexpr int s_deltaForTouches{ 50 };
+    inline static constexpr float s_deltaForTouches{ 50.0f };
+    inline static constexpr float s_minCameraHeight{ 0.5f };
+    inline static constexpr float s_maxCameraHeight{ 1.3f };
 
     int m_framerate{ 150 };
 
@@ -61,7 +65,10 @@ public:
     "window_name": "Pirate Game",
     "window_width": 800,
     "window_height": 600,
-    "is_window_resizable": true
+    "is_window_resizable": true,
+    "fixed_update_rate": 60,
+    "max_fixed_update_steps": 5,
+    "log_level": "info"
 }
 )");
         Sprite::setOriginalSize(s_originalWindowSize);
@@ -256,52 +263,63 @@ public:
         player->resizeUpdate();
     }
 
-    void onEvent(const Event& event) override {
-        switch (event.type) {
-        case Event::Type::key_down:
-            if (m_isOnShip) {
-                if (event.keyboard.key == Config::ship_move_key) {
-                    ship->move();
-                    break;
-                }
-
-                if (event.keyboard.key == Config::ship_rotate_left_key) {
+    void onInput(const InputState& input) override {
+        // Movement follows the held keys, a release only stops what the key started so touch
+        // controls keep working.
+        const auto applyHeldKey{ [&input](Event::Keyboard::Key key, auto start, auto stop) {
+            if (input.isKeyDown(key))
+                start();
+            else if (input.wasKeyReleased(key))
+                stop();
+        } };
+
+        if (m_isOnShip) {
+            applyHeldKey(
+                Config::ship_move_key, [this] { ship->move(); }, [this] { ship->stopMove(); });
+            applyHeldKey(
+                Config::ship_rotate_left_key,
+                [this] {
                     ship->rotateLeft();
                     ship->setInteract(false);
-                    break;
-                }
-
-                if (event.keyboard.key == Config::ship_rotate_right_key) {
+                },
+                [this] { ship->stopRotateLeft(); });
+            applyHeldKey(
+                Config::ship_rotate_right_key,
+                [this] {
                     ship->rotateRight();
                     ship->setInteract(false);
-                    break;
-                }
-            }
-            else {
-                if (event.keyboard.key == Config::player_move_up_key) {
-                    player->moveUp();
-                    break;
-                }
-
-                if (event.keyboard.key == Config::player_move_left_key) {
-                    player->moveLeft();
-                    break;
-                }
-
-                if (event.keyboard.key == Config::player_move_right_key) {
-                    player->moveRight();
-                    break;
-                }
+                },
+                [this] { ship->stopRotateRight(); });
+        }
+        else {
+            applyHeldKey(
+                Config::player_move_up_key,
+                [this] { player->moveUp(); },
+                [this] { player->stopMoveUp(); });
+            applyHeldKey(
+                Config::player_move_left_key,
+                [this] { player->moveLeft(); },
+                [this] { player->stopMoveLeft(); });
+            applyHeldKey(
+                Config::player_move_right_key,
+                [this] { player->moveRight(); },
+                [this] { player->stopMoveRight(); });
+            applyHeldKey(
+                Config::player_move_down_key,
+                [this] { player->moveDown(); },
+                [this] { player->stopMoveDown(); });
+        }
 
-                if (event.keyboard.key == Config::player_move_down_key) {
-                    player->moveDown();
-                    break;
-                }
+        for (const auto& event : input.events)
+            onEvent(event);
+    }
 
-                if (event.keyboard.key == Config::dig_treasure_key) {
-                    player->tryDig();
-                    break;
-                }
+    void onEvent(const Event& event) override {
+        switch (event.type) {
+        case Event::Type::key_down:
+            if (!m_isOnShip && event.keyboard.key == Config::dig_treasure_key) {
+                player->tryDig();
+                break;
             }
 
             if (event.keyboard.key == Config::interact_key) {
@@ -360,46 +378,6 @@ public:
                 break;
             }
 
-            break;
-        case Event::Type::key_up:
-            if (m_isOnShip) {
-                if (event.keyboard.key == Config::ship_move_key) {
-                    ship->stopMove();
-                    break;
-                }
-
-                if (event.keyboard.key == Config::ship_rotate_left_key) {
-                    ship->stopRotateLeft();
-                    break;
-                }
-
-                if (event.keyboard.key == Config::ship_rotate_right_key) {
-                    ship->stopRotateRight();
-                    break;
-                }
-            }
-            else {
-                if (event.keyboard.key == Config::player_move_up_key) {
-                    player->stopMoveUp();
-                    break;
-                }
-
-                if (event.keyboard.key == Config::player_move_left_key) {
-                    player->stopMoveLeft();
-                    break;
-                }
-
-                if (event.keyboard.key == Config::player_move_right_key) {
-                    player->stopMoveRight();
-                    break;
-                }
-
-                if (event.keyboard.key == Config::player_move_down_key) {
-                    player->stopMoveDown();
-                    break;
-                }
-            }
-
             break;
 
         case Event::Type::window_resized:
@@ -443,70 +421,51 @@ public:
 
             break;
 
-        case Event::Type::touch_motion:
-            if (event.touch.id == 0) {
-                if (m_isOnShip) {
-                    switch (static_cast<int>(event.touch.dy)) {
-                    case s_deltaForTouches ... INT_MAX:
-                        ship->move();
-                        break;
-
-                    default:
-                        ship->stopMove();
-                        break;
-                    }
-
-                    switch (static_cast<int>(event.touch.dx)) {
-                    case INT_MIN ... - s_deltaForTouches:
-                        ship->stopRotateRight();
-                        ship->rotateLeft();
-                        break;
-
-                    case s_deltaForTouches ... INT_MAX:
-                        ship->stopRotateLeft();
-                        ship->rotateRight();
-                        break;
-
-                    default:
-                        ship->stopRotateLeft();
-                        ship->stopRotateRight();
-                        break;
-                    }
+        case Event::Type::gesture_drag:
+            if (m_isOnShip) {
+                if (event.gesture.dy >= s_deltaForTouches)
+                    ship->move();
+                else
+                    ship->stopMove();
+
+                if (event.gesture.dx <= -s_deltaForTouches) {
+                    ship->stopRotateRight();
+                    ship->rotateLeft();
+                }
+                else if (event.gesture.dx >= s_deltaForTouches) {
+                    ship->stopRotateLeft();
+                    ship->rotateRight();
                 }
                 else {
-                    switch (static_cast<int>(event.touch.dy)) {
-                    case s_deltaForTouches ... INT_MAX:
-                        player->stopMoveDown();
-                        player->moveUp();
-                        break;
-
-                    case INT_MIN ... - s_deltaForTouches:
-                        player->stopMoveUp();
-                        player->moveDown();
-                        break;
-
-                    default:
-                        player->stopMoveUp();
-                        player->stopMoveDown();
-                        break;
-                    }
-
-                    switch (static_cast<int>(event.touch.dx)) {
-                    case s_deltaForTouches ... INT_MAX:
-                        player->stopMoveLeft();
-                        player->moveRight();
-                        break;
-
-                    case INT_MIN ... - s_deltaForTouches:
-                        player->stopMoveRight();
-                        player->moveLeft();
-                        break;
-
-                    default:
-                        player->stopMoveLeft();
-                        player->stopMoveRight();
-                        break;
-                    }
+                    ship->stopRotateLeft();
+                    ship->stopRotateRight();
+                }
+            }
+            else {
+                if (event.gesture.dy >= s_deltaForTouches) {
+                    player->stopMoveDown();
+                    player->moveUp();
+                }
+                else if (event.gesture.dy <= -s_deltaForTouches) {
+                    player->stopMoveUp();
+                    player->moveDown();
+                }
+                else {
+                    player->stopMoveUp();
+                    player->stopMoveDown();
+                }
+
+                if (event.gesture.dx >= s_deltaForTouches) {
+                    player->stopMoveLeft();
+                    player->moveRight();
+                }
+                else if (event.gesture.dx <= -s_deltaForTouches) {
+                    player->stopMoveRight();
+                    player->moveLeft();
+                }
+                else {
+                    player->stopMoveLeft();
+                    player->stopMoveRight();
                 }
             }
             break;
@@ -523,28 +482,49 @@ public:
             }
             break;
 
+        case Event::Type::gesture_pinch:
+            // Same range as the menu slider, updateView applies it to the view.
+            Config::camera_height = std::clamp(
+                Config::camera_height * event.gesture.scale, s_minCameraHeight, s_maxCameraHeight);
+            break;
+
         default:
             break;
         }
     }
 
-    void render() override {
+    void render(float alpha) override {
         if (menu.getActive()) {
             menu.render();
             return;
         }
 
-        if (m_viewOnTreasure) {
-            getEngineInstance()->render(map->getTreasure().getXMarkSprite(), m_view);
+        if (!m_viewOnTreasure) {
+            if (m_isOnShip)
+                updateView(ship->interpolate(alpha));
+            else
+                updateView(player->interpolate(alpha));
         }
-        else {
-            if (!m_isOnShip) getEngineInstance()->render(player->getSprite(), m_view);
-            getEngineInstance()->render(ship->getSprite(), m_view);
-            if (map->isTreasureUnearthed())
-                getEngineInstance()->render(map->getTreasure().getTreasureSprite(), m_view);
+        else
+            updateView(map->getTreasure().getPosition());
+
+        {
+            const GpuScope gpuScope{ "sprites" };
+            if (m_viewOnTreasure) {
+                getEngineInstance()->render(map->getTreasure().getXMarkSprite(), m_view);
+            }
+            else {
+                if (!m_isOnShip) getEngineInstance()->render(player->getSprite(), m_view);
+                getEngineInstance()->render(ship->getSprite(), m_view);
+                if (map->isTreasureUnearthed())
+                    getEngineInstance()->render(map->getTreasure().getTreasureSprite(), m_view);
+            }
         }
 
-        map->render(m_view);
+        {
+            const GpuScope gpuScope{ "map" };
+            map->render(m_view);
+        }
 
         ImGui::SetNextWindowPos({ getEngineInstance()->getWindowSize().width - 150.0f, 0.0f });
         ImGui::Begin("_",
@@ -615,60 +595,45 @@ public:
 #endif
     }
 
-    void update() override {
-        static auto time{ std::chrono::steady_clock::now() };
-        auto now{ std::chrono::steady_clock::now() };
-        std::chrono::microseconds timeElapsed{
-            std::chrono::duration_cast<std::chrono::microseconds>(now - time)
-        };
-        time = now;
+    void fixedUpdate(std::chrono::microseconds step) override {
+        if (m_viewOnTreasure) return;
 
-        if (!m_viewOnTreasure) {
-            if (m_isOnShip) {
-                map->interact(*ship);
-                ship->update(timeElapsed);
-            }
-            else {
-                map->interact(*player);
-                player->update(timeElapsed);
-            }
-
-            if (m_isOnShip)
-                m_view.setPosition(ship->getPosition());
-            else
-                m_view.setPosition(player->getPosition());
+        if (m_isOnShip) {
+            ship->interpolate(1.0f);
+            map->interact(*ship);
+            ship->update(step);
         }
-        else
-            m_view.setPosition(map->getTreasure().getPosition());
-
-        m_view.setScale(Config::camera_height);
-
-        Position viewPos{ m_view.getPosition() };
-        if (m_view.getPosition().x <
-            getEngineInstance()->getWindowSize().width / 2.0f / m_view.getScale() - 400.f)
-            viewPos.x =
-                getEngineInstance()->getWindowSize().width / 2.0f / m_view.getScale() - 400.f;
-        if (m_view.getPosition().y <
-            getEngineInstance()->getWindowSize().height / 2.0f / m_view.getScale() - 300.f)
-            viewPos.y =
-                getEngineInstance()->getWindowSize().height / 2.0f / m_view.getScale() - 300.f;
-        if (m_view.getPosition().x >
-            8000 - getEngineInstance()->getWindowSize().width / 2.0f / m_view.getScale() - 400.f)
-            viewPos.x = 8000 -
-                        getEngineInstance()->getWindowSize().width / 2.0f / m_view.getScale() -
-                        400.f;
-        if (m_view.getPosition().y >
-            8000 - getEngineInstance()->getWindowSize().height / 2.0f / m_view.getScale() - 300.f)
-            viewPos.y = 8000 -
-                        getEngineInstance()->getWindowSize().height / 2.0f / m_view.getScale() -
-                        300.f;
-
-        m_view.setPosition(viewPos);
+        else {
+            player->interpolate(1.0f);
+            map->interact(*player);
+            player->update(step);
+        }
+    }
 
+    void update() override {
         if (m_isDebugMenuOn) {
             ImGui::Begin("Debug Menu");
             ImGui::Text("FPS = %.1f ", ImGui::GetIO().Framerate);
 
+            const auto frameStats{ getEngineInstance()->getFrameTimeStats() };
+            ImGui::Text("frame time p50: %.2f ms  p99: %.2f ms  max: %.2f ms",
+                        std::chrono::duration<float, std::milli>{ frameStats.p50 }.count(),
+                        std::chrono::duration<float, std::milli>{ frameStats.p99 }.count(),
+                        std::chrono::duration<float, std::milli>{ frameStats.max }.count());
+            ImGui::PlotLines("##frame time",
+                             frameStats.historyMs.data(),
+                             static_cast<int>(frameStats.historyMs.size()),
+                             static_cast<int>(frameStats.historyOffset),
+                             "frame time, ms",
+                             0.0f,
+                             std::chrono::duration<float, std::milli>{ frameStats.p99 }.count() *
+                                 2.0f,
+                             ImVec2{ 0, 60 });
+
+            bool isProfilerVisible{ Profiler::getInstance().isWindowVisible() };
+            if (ImGui::Checkbox("Profiler", &isProfilerVisible))
+                Profiler::getInstance().setWindowVisible(isProfilerVisible);
+
             ImGui::SliderInt("FPS", &m_framerate, 60, 300);
             if (ImGui::Button("Apply FPS")) { getEngineInstance()->setFramerate(m_framerate); }
 
@@ -695,6 +660,26 @@ public:
             ImGui::End();
         }
     }
+
+private:
+    void updateView(Position target) {
+        m_view.setPosition(target);
+        m_view.setScale(Config::camera_height);
+
+        // Half of the visible area in world units.
+        const auto [width, height]{ getEngineInstance()->getWindowSize() };
+        const float halfWidth{ static_cast<float>(width) / 2.0f / m_view.getScale() };
+        const float halfHeight{ static_cast<float>(height) / 2.0f / m_view.getScale() };
+
+        const Position position{ m_view.getPosition() };
+        Position viewPos{ position };
+        if (position.x < halfWidth - 400.f) viewPos.x = halfWidth - 400.f;
+        if (position.y < halfHeight - 300.f) viewPos.y = halfHeight - 300.f;
+        if (position.x > 8000 - halfWidth - 400.f) viewPos.x = 8000 - halfWidth - 400.f;
+        if (position.y > 8000 - halfHeight - 300.f) viewPos.y = 8000 - halfHeight - 300.f;
+
+        m_view.setPosition(viewPos);
+    }
 };
 
 IGame* createGame(IEngine* engine) {
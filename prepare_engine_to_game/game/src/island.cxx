@@ -69,13 +69,12 @@ void Island::interact(Player& player) {
 }
 
 bool Island::isIslandOnView(Position position) const noexcept {
-    auto viewPos{ position };
-    auto leftX{ viewPos.x - (getEngineInstance()->getWindowSize().width / 2.0f) };
-    auto leftY{ viewPos.y - (getEngineInstance()->getWindowSize().height / 2.0f) };
+    const auto [width, height]{ getEngineInstance()->getWindowSize() };
+    const Size viewSize{ static_cast<float>(width), static_cast<float>(height) };
 
-    Rectangle viewRect{ .xy{ leftX, leftY },
-                        .wh = { static_cast<float>(getEngineInstance()->getWindowSize().width),
-                                static_cast<float>(getEngineInstance()->getWindowSize().height) } };
+    Rectangle viewRect{ .xy{ position.x - viewSize.width / 2.0f,
+                             position.y - viewSize.height / 2.0f },
+                        .wh = viewSize };
 
     return intersect(viewRect, m_rectangle).has_value();
 }
@@ -4,14 +4,7 @@
 
 #include "engine.hxx"
 
-static int generateRandomNumber(int min, int max) {
-    static std::seed_seq seed{
-        std::random_device{}(),
-        static_cast<unsigned>(std::chrono::high_resolution_clock::now().time_since_epoch().count())
-    };
-
-    static std::mt19937_64 engine{ seed };
-
+static int generateRandomNumber(std::mt19937_64& engine, int min, int max) {
     std::uniform_int_distribution die{ min, max };
     return die(engine);
 }
@@ -25,10 +18,11 @@ Map::Map(const fs::path& waterTexturePath,
          Size mapSize)
     : m_waterSprite{ waterTexturePath, textureSize }
     , m_airSprite{ airTexturePath, textureSize }
-    , m_bottle{ bottleTexturePath, textureSize }
+    , m_bottleSprite{ bottleTexturePath, textureSize }
     , m_treasure{ treasureTexturePath, xMarkTexturePath, textureSize }
     , m_textureSize{ textureSize }
-    , m_mapSize{ mapSize } {
+    , m_mapSize{ mapSize }
+    , m_randomEngine{ getEngineInstance()->getRandomSeed() } {
     float xOffset = -((800 / 2.0f) - (m_textureSize.width / 2.0f));
     float yOffset = -((600 / 2.0f) - (m_textureSize.height / 2.0f));
     for (std::ptrdiff_t h{}; h < m_mapSize.height / m_textureSize.height; ++h) {
@@ -107,6 +101,8 @@ Map::Map(const fs::path& waterTexturePath,
 
     m_bottleVertexBuffer = std::make_unique<VertexBuffer<Vertex2>>(v2);
     m_bottleIndexBuffer = std::make_unique<IndexBuffer<std::uint32_t>>(u32);
+
+    m_bottleRegion = m_bottles.addRegion({ .size = textureSize });
 }
 
 void Map::addIsland(Position position, const std::vector<std::string>& pattern) {
@@ -190,7 +186,8 @@ void Map::resizeUpdate() {
     for (auto& island : m_islands)
         island.resizeUpdate();
 
-    m_bottle.resizeUpdate();
+    m_bottleSprite.updateWindowSize();
+    m_bottleSprite.checkAspect({ 800, 600 });
     m_treasure.resizeUpdate();
 
     m_waterSprite.updateWindowSize();
@@ -230,11 +227,12 @@ void Map::render(const View& view) {
                                     view);
     }
 
-    m_bottle.setPosition({ 0, 0 });
+    if (m_bottles.getVersion() != m_bottlesVersion) updateBottleBuffers();
+    m_bottleSprite.setPosition({ 0, 0 });
     getEngineInstance()->render(*m_bottleVertexBuffer,
                                 *m_bottleIndexBuffer,
-                                m_bottle.getSprite().getTexture(),
-                                m_bottle.getSprite().getResultMatrix(),
+                                m_bottleSprite.getTexture(),
+                                m_bottleSprite.getResultMatrix(),
                                 view);
 
     m_waterSprite.setPosition({ 0, 0 });
@@ -259,16 +257,12 @@ void Map::interact(Ship& ship) {
         }
 
     if (!ship.getPlayer().hasBottle()) {
-        for (std::size_t i{}; i < m_bottlePositions.size(); ++i) {
-            m_bottle.setPosition(m_bottlePositions[i]);
-            if (intersect(m_bottle.getSprite(), ship.getSprite())) {
-                generateTreasure();
-                ship.getPlayer().setBottle(true);
-                m_isTreasureUnearthed = false;
-                m_bottlePositions.erase(m_bottlePositions.begin() + i);
-                generateBottles();
-                break;
-            }
+        if (auto bottle{ m_bottles.findOverlap(ship.getSprite().getRectangle()) }) {
+            generateTreasure();
+            ship.getPlayer().setBottle(true);
+            m_isTreasureUnearthed = false;
+            m_bottles.destroy(*bottle);
+            generateBottles();
         }
     }
 
@@ -305,18 +299,18 @@ void Map::interact(Player& player) {
 
 void Map::generateBottles() {
     while (m_countOfBottles < s_maxCountOfBottles) {
-        auto randomPos{ generateRandomNumber(0, static_cast<int>(m_waterPositions.size()) - 1) };
-        m_bottlePositions.emplace_back(m_waterPositions.at(randomPos));
+        auto randomPos{ generateRandomNumber(
+            m_randomEngine, 0, static_cast<int>(m_waterPositions.size()) - 1) };
+        m_bottles.create(m_waterPositions.at(randomPos), m_bottleRegion);
         ++m_countOfBottles;
     }
-
-    updateBottlePositions();
 }
 
 void Map::generateTreasure() {
-    auto rndIsland{ generateRandomNumber(0, static_cast<int>(m_islands.size()) - 1) };
+    auto rndIsland{ generateRandomNumber(
+        m_randomEngine, 0, static_cast<int>(m_islands.size()) - 1) };
     auto rndPos{ generateRandomNumber(
-        0, static_cast<int>(m_islands[rndIsland].getPositions().size()) - 1) };
+        m_randomEngine, 0, static_cast<int>(m_islands[rndIsland].getPositions().size()) - 1) };
     auto pos{ m_islands[rndIsland].getPositions().at(rndPos).second };
     m_treasure.setPosition(pos);
 }
@@ -325,61 +319,16 @@ Treasure& Map::getTreasure() noexcept { return m_treasure; }
 
 bool Map::isTreasureUnearthed() const noexcept { return m_isTreasureUnearthed; }
 
-void Map::updateBottlePositions() {
-    std::vector<Vertex2> vertices{};
-    std::vector<std::uint32_t> indices{};
-    for (auto pos : m_bottlePositions) {
-        auto leftXpos{ (pos.x + 400) - m_textureSize.width / 2.0f };
-        auto rightXpos{ (pos.x + 400) + m_textureSize.width / 2.0f };
-        auto topYpos{ (pos.y + 300) + m_textureSize.height / 2.0f };
-        auto bottomYpos{ (pos.y + 300) - m_textureSize.height / 2.0f };
-
-        auto normalizedXLeftPos{ (leftXpos / (800.f * 0.5f)) - 1.0f };
-        auto normalizedXRightPos{ (rightXpos / (800.f * 0.5f)) - 1.0f };
-        auto normalizedYTopPos{ (topYpos / (600.f * 0.5f)) - 1.0f };
-        auto normalizedYBottomPos{ (bottomYpos / (600.f * 0.5f)) - 1.0f };
-
-        Vertex2 v1{};
-        v1.x = normalizedXLeftPos;
-        v1.y = normalizedYTopPos;
-        v1.texX = 0.0;
-        v1.texY = 0.0;
-
-        vertices.push_back(v1);
-        auto firstIdx{ vertices.size() - 1 };
+void Map::updateBottleBuffers() {
+    // Same NDC space as the water grid: 800x600 window units around the origin.
+    const auto vertices{ m_bottleVertexBuffer->beginStream(m_bottles.size() * 4) };
+    m_bottles.buildQuads({ 2.0f / 800.f, 2.0f / 600.f }, vertices);
+    m_bottleVertexBuffer->endStream();
 
-        Vertex2 v2{};
-        v2.x = normalizedXRightPos;
-        v2.y = normalizedYTopPos;
-        v2.texX = 1.0;
-        v2.texY = 0.0;
-        vertices.push_back(v2);
-        auto secondIdx{ vertices.size() - 1 };
-
-        Vertex2 v3{};
-        v3.x = normalizedXRightPos;
-        v3.y = normalizedYBottomPos;
-        v3.texX = 1.0;
-        v3.texY = 1.0;
-        vertices.push_back(v3);
-        auto thirdIdx{ vertices.size() - 1 };
-
-        Vertex2 v4{};
-        v4.x = normalizedXLeftPos;
-        v4.y = normalizedYBottomPos;
-        v4.texX = 0.0;
-        v4.texY = 1.0;
-        vertices.push_back(v4);
-        auto fourthIdx{ vertices.size() - 1 };
-
-        indices.push_back(firstIdx);
-        indices.push_back(secondIdx);
-        indices.push_back(thirdIdx);
-
-        indices.push_back(firstIdx);
-        indices.push_back(thirdIdx);
-        indices.push_back(fourthIdx);
+    if (m_bottleIndexBuffer->size() != m_bottles.size() * 6) {
+        std::vector<std::uint32_t> indices{};
+        EntityStore::buildQuadIndices(m_bottles.size(), indices);
+        m_bottleIndexBuffer->updateData(std::move(indices));
     }
-    m_bottleVertexBuffer->updateData(std::move(vertices));
-    m_bottleIndexBuffer->updateData(std::move(indices));
+    m_bottlesVersion = m_bottles.getVersion();
 }
@@ -2,13 +2,14 @@
 #define ENGINE_PREPARE_TO_GAME_MAP_HXX
 
 #include <array>
+#include <entity_store.hxx>
 #include <filesystem>
 #include <memory>
+#include <random>
 #include <sprite.hxx>
 #include <vector>
 #include <view.hxx>
 
-#include "bottle.hxx"
 #include "island.hxx"
 #include "player.hxx"
 #include "ship.hxx"
@@ -22,7 +23,7 @@ private:
     Sprite m_waterSprite;
     Sprite m_airSprite;
 
-    Bottle m_bottle;
+    Sprite m_bottleSprite;
     Treasure m_treasure;
 
     Size m_textureSize{};
@@ -33,7 +34,11 @@ private:
     std::vector<Island> m_islands{};
     std::vector<Position> m_waterPositions{};
     std::vector<Position> m_airPositions{};
-    std::vector<Position> m_bottlePositions{};
+
+    // Bottles only differ by position, they are entities drawn with the texture of m_bottleSprite.
+    EntityStore m_bottles{};
+    EntityStore::RegionId m_bottleRegion{};
+    std::uint64_t m_bottlesVersion{};
 
     std::unique_ptr<VertexBuffer<Vertex2>> m_gridPtr{};
     std::unique_ptr<IndexBuffer<std::uint32_t>> m_idxGridPtr{};
@@ -50,6 +55,9 @@ private:
 
     Island* m_interactIsland{};
 
+    // Seeded from the engine, so bottles and treasure are the same in a replayed session.
+    std::mt19937_64 m_randomEngine;
+
 public:
     Map(const fs::path& waterTexturePath,
         const fs::path& airTexturePath,
@@ -76,7 +84,7 @@ public:
     Treasure& getTreasure() noexcept;
 
 private:
-    void updateBottlePositions();
+    void updateBottleBuffers();
 };
 
 #endif // ENGINE_PREPARE_TO_GAME_MAP_HXX
@@ -51,6 +51,7 @@ void Player::stopMoveDown() {
 
 void Player::setPosition(Position position) {
     m_position = position;
+    m_lastPosition = position;
     m_sprite.setPosition(m_position);
     m_sprite.setTexture(m_textures["front"][0]);
 }
@@ -104,6 +105,13 @@ void Player::update(std::chrono::microseconds timeElapsed) {
     m_sprite.setPosition(m_position);
 }
 
+Position Player::interpolate(float alpha) {
+    Position position{ m_lastPosition.x + (m_position.x - m_lastPosition.x) * alpha,
+                       m_lastPosition.y + (m_position.y - m_lastPosition.y) * alpha };
+    m_sprite.setPosition(position);
+    return position;
+}
+
 const Sprite& Player::getSprite() const noexcept { return m_sprite; }
 
 void Player::tryDig() {
@@ -56,6 +56,8 @@ public:
     [[nodiscard]] const Sprite& getSprite() const noexcept;
     void resizeUpdate();
     void update(std::chrono::microseconds timeElapsed);
+    // Places the sprite between the previous and the current update, returns its position.
+    Position interpolate(float alpha);
 
     void forceStop();
 
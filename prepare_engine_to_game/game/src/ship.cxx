@@ -55,13 +55,15 @@ void Ship::update(std::chrono::microseconds timeElapsed) {
     float deltaY{ m_currentMoveSpeed * timeElapsedInSec };
     float deltaAngle{ m_currentRotateSpeed * timeElapsedInSec };
 
-    float newAngle{ m_sprite.getRotate().getInDegrees() + deltaAngle };
+    float newAngle{ m_angle + deltaAngle };
     if (newAngle > 360)
         newAngle -= 360;
     else if (newAngle < 0)
         newAngle += 360;
 
-    m_sprite.setRotate(newAngle);
+    m_lastAngle = m_angle;
+    m_angle = newAngle;
+    m_sprite.setRotate(m_angle);
 
     float newX = m_position.x + deltaX * std::cos(m_sprite.getRotate().getInRadians()) -
                  deltaY * std::sin(m_sprite.getRotate().getInRadians());
@@ -77,6 +79,27 @@ void Ship::update(std::chrono::microseconds timeElapsed) {
     m_sprite.setPosition(m_position);
 }
 
+Position Ship::interpolate(float alpha) {
+    float deltaAngle{ m_angle - m_lastAngle };
+    if (deltaAngle > 180)
+        deltaAngle -= 360;
+    else if (deltaAngle < -180)
+        deltaAngle += 360;
+
+    float angle{ m_lastAngle + deltaAngle * alpha };
+    if (angle > 360)
+        angle -= 360;
+    else if (angle < 0)
+        angle += 360;
+
+    Position position{ m_lastPosition.x + (m_position.x - m_lastPosition.x) * alpha,
+                       m_lastPosition.y + (m_position.y - m_lastPosition.y) * alpha };
+
+    m_sprite.setRotate(angle);
+    m_sprite.setPosition(position);
+    return position;
+}
+
 Ship::Config& Ship::config() noexcept { return m_config; }
 
 const Sprite& Ship::getSprite() const noexcept { return m_sprite; }
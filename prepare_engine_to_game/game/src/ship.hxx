@@ -26,6 +26,8 @@ public:
 private:
     Position m_position{};
     Position m_lastPosition{};
+    float m_angle{};
+    float m_lastAngle{};
 
     bool m_isMove{};
     bool m_isRotateLeft{};
@@ -59,6 +61,8 @@ public:
 
     void resizeUpdate();
     void update(std::chrono::microseconds timeElapsed);
+    // Places the sprite between the previous and the current update, returns its position.
+    Position interpolate(float alpha);
 
     [[nodiscard]] const Sprite& getSprite() const noexcept;
     [[nodiscard]] float getMoveSpeed() const noexcept;
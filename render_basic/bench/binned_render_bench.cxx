@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+#include <thread>
+
+#include "../src/binned_render.hxx"
+#include "../src/canvas.hxx"
+#include "../src/thread_pool.hxx"
+#include "../src/tile_rasterizer.hxx"
+
+using namespace std::literals;
+
+// The circle and grid scenes of main.cxx on a 1920x1080 canvas, the grid filled with vertex
+// colours instead of drawn as outlines.
+static constexpr std::size_t s_width{ 1920 };
+static constexpr std::size_t s_height{ 1080 };
+static constexpr int s_runs{ 20 };
+
+struct Scene
+{
+    std::string_view name{};
+    std::vector<graphics::Vertex> vertices{};
+    std::vector<std::uint16_t> indices{};
+};
+
+static Scene makeCircle() {
+    constexpr unsigned segments{ 60 };
+    constexpr double centerX{ 300.0 };
+    constexpr double centerY{ 300.0 };
+    constexpr double radius{ 200.0 };
+
+    Scene scene{ .name = "circle"sv };
+    scene.vertices.push_back({ centerX, centerY, 255.0, 255.0, 255.0 });
+    for (unsigned i{}; i <= segments; ++i) {
+        const double angle{ 2.0 * std::numbers::pi * i / segments };
+        scene.vertices.push_back({ centerX + radius * std::cos(angle),
+                                   centerY + radius * std::sin(angle),
+                                   static_cast<double>(i * 37 % 256),
+                                   static_cast<double>(i * 91 % 256),
+                                   static_cast<double>(i * 53 % 256) });
+    }
+    for (unsigned i{ 1 }; i <= segments; ++i) {
+        const auto index{ static_cast<std::uint16_t>(i) };
+        const auto next{ static_cast<std::uint16_t>(i + 1) };
+        scene.indices.insert(scene.indices.end(), { 0, index, next });
+    }
+    return scene;
+}
+
+static Scene makeGrid() {
+    constexpr std::size_t xMax{ 20 };
+    constexpr std::size_t yMax{ 20 };
+    constexpr std::size_t stepX{ (s_width - 1) / xMax };
+    constexpr std::size_t stepY{ (s_height - 1) / yMax };
+
+    Scene scene{ .name = "grid"sv };
+    for (std::size_t i{}; i <= yMax; ++i)
+        for (std::size_t j{}; j <= xMax; ++j)
+            scene.vertices.push_back({ static_cast<double>(j * stepX),
+                                       static_cast<double>(i * stepY),
+                                       static_cast<double>(j * 255 / xMax),
+                                       static_cast<double>(i * 255 / yMax),
+                                       128.0 });
+
+    for (std::size_t i{}; i < yMax; ++i)
+        for (std::size_t j{}; j < xMax; ++j) {
+            const auto index0{ static_cast<std::uint16_t>(i * (xMax + 1) + j) };
+            const auto index1{ static_cast<std::uint16_t>((i + 1) * (xMax + 1) + j + 1) };
+            const auto index2{ static_cast<std::uint16_t>(index1 - 1) };
+            const auto index3{ static_cast<std::uint16_t>(index0 + 1) };
+            scene.indices.insert(scene.indices.end(),
+                                 { index0, index1, index2, index0, index1, index3 });
+        }
+    return scene;
+}
+
+template <typename Render>
+static double measure(graphics::Canvas& canvas, Render& render, const Scene& scene) {
+    auto best{ std::chrono::nanoseconds::max() };
+    for (int i{}; i < s_runs; ++i) {
+        canvas.clear();
+        const auto start{ std::chrono::steady_clock::now() };
+        render.drawTriangles(scene.vertices, scene.indices);
+        const auto time{ std::chrono::steady_clock::now() - start };
+        best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(time));
+    }
+    return static_cast<double>(best.count()) / 1e6;
+}
+
+int main() {
+    std::cout << "best of "sv << s_runs << " runs, "sv << s_width << 'x' << s_height << ", "sv
+              << std::thread::hardware_concurrency() << " hardware threads\n"sv;
+
+    graphics::Canvas canvas{ s_width, s_height };
+    graphics::VertexColorGfx gfx{};
+
+    for (const auto& scene : { makeCircle(), makeGrid() }) {
+        graphics::TileRasterizer tile{ canvas, gfx };
+        std::cout << '\n'
+                  << scene.name << ", "sv << scene.indices.size() / 3 << " triangles\n"sv
+                  << std::setw(10) << "threads"sv << std::setw(12) << "ms"sv << std::setw(12)
+                  << "speedup"sv << '\n'
+                  << std::setw(10) << "tile"sv << std::fixed << std::setprecision(2)
+                  << std::setw(12) << measure(canvas, tile, scene) << '\n';
+
+        double single{};
+        for (const std::size_t threads : { 1, 2, 4, 8, 16 }) {
+            graphics::ThreadPool pool{ threads };
+            graphics::BinnedRender binned{ canvas, gfx, pool };
+            const auto ms{ measure(canvas, binned, scene) };
+            if (threads == 1) single = ms;
+            std::cout << std::setw(10) << threads << std::setw(12) << ms << std::setw(12)
+                      << single / ms << '\n';
+        }
+    }
+}
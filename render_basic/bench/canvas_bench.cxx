@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "../src/canvas.hxx"
+#include "../src/line_render.hxx"
+
+using namespace std::literals;
+
+// Clears and lines on a 3840x2160 canvas with 64 byte rows.
+static constexpr std::size_t s_width{ 3840 };
+static constexpr std::size_t s_height{ 2160 };
+static constexpr std::size_t s_lines{ 20000 };
+static constexpr int s_runs{ 10 };
+
+template <typename Draw>
+static double measure(Draw&& draw) {
+    auto best{ std::chrono::nanoseconds::max() };
+    for (int i{}; i < s_runs; ++i) {
+        const auto start{ std::chrono::steady_clock::now() };
+        draw();
+        const auto time{ std::chrono::steady_clock::now() - start };
+        best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(time));
+    }
+    return static_cast<double>(best.count()) / 1e6;
+}
+
+// Pixels per millisecond in millions per second.
+static void report(std::string_view name, double ms, std::size_t pixels) {
+    const auto bytes{ static_cast<double>(pixels * sizeof(graphics::Color)) };
+    std::cout << std::setw(12) << name << std::fixed << std::setprecision(2) << std::setw(10)
+              << ms << std::setw(12) << static_cast<double>(pixels) / ms / 1e3 << std::setw(10)
+              << bytes / ms / 1e6 << '\n';
+}
+
+int main() {
+    std::cout << "best of "sv << s_runs << " runs, "sv << s_width << 'x' << s_height << '\n'
+              << std::setw(12) << "test"sv << std::setw(10) << "ms"sv << std::setw(12)
+              << "Mpixel/s"sv << std::setw(10) << "GB/s"sv << '\n';
+
+    graphics::Canvas canvas{ s_width, s_height, 16 };
+    const auto pixels{ canvas.getPixels().size() };
+
+    const graphics::Color color{ 10, 20, 30 };
+    report("fill"sv, measure([&] { std::ranges::fill(canvas.getPixels(), color); }), pixels);
+    report("clear"sv, measure([&] { canvas.clear(color); }), pixels);
+    report("fill rect"sv,
+           measure([&] { canvas.fillRect({ 0, 0 }, s_width, s_height, color); }),
+           s_width * s_height);
+
+    std::vector<std::pair<graphics::Position, graphics::Position>> lines(s_lines);
+    for (unsigned i{}; i < s_lines; ++i)
+        lines[i] = { graphics::Position::generateRandom(s_width, s_height, i + 1),
+                     graphics::Position::generateRandom(s_width, s_height, i + 1 + s_lines) };
+
+    graphics::LineRender render{ canvas, s_width, s_height };
+    std::size_t linePixels{};
+    for (const auto& [start, end] : lines)
+        linePixels += render.pixelPositions(start, end).size();
+
+    report("positions"sv,
+           measure([&] {
+               for (const auto& [start, end] : lines)
+                   for (const auto position : render.pixelPositions(start, end))
+                       canvas.setPixel(position, color);
+           }),
+           linePixels);
+    report("lines"sv,
+           measure([&] {
+               for (const auto& [start, end] : lines)
+                   render.drawLine(start, end, color);
+           }),
+           linePixels);
+}
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "../src/canvas.hxx"
+#include "../src/fragment_batch.hxx"
+#include "../src/pipeline_state.hxx"
+#include "../src/tile_rasterizer.hxx"
+
+using namespace std::literals;
+
+// Overlapping opaque layers on a 1920x1080 canvas, each quad a little smaller than the one
+// behind it, drawn from the far one to the near one and back.
+static constexpr std::size_t s_width{ 1920 };
+static constexpr std::size_t s_height{ 1080 };
+static constexpr std::size_t s_layers{ 16 };
+static constexpr int s_runs{ 10 };
+
+struct Scene
+{
+    std::vector<graphics::Vertex> vertices{};
+    std::vector<std::uint16_t> backToFront{};
+    std::vector<std::uint16_t> frontToBack{};
+};
+
+static Scene makeScene() {
+    Scene scene{};
+    for (std::size_t layer{}; layer < s_layers; ++layer) {
+        const double inset{ static_cast<double>(layer) * 20.0 };
+        const double depth{ 1.0 - static_cast<double>(layer + 1) / (s_layers + 1) };
+        const double shade{ static_cast<double>(layer * 255 / s_layers) };
+        const auto first{ static_cast<std::uint16_t>(scene.vertices.size()) };
+        scene.vertices.insert(scene.vertices.end(),
+                              { { inset, inset, shade, 0, 255 - shade, depth },
+                                { s_width - inset, inset, 0, shade, 255 - shade, depth },
+                                { s_width - inset, s_height - inset, shade, shade, 0, depth },
+                                { inset, s_height - inset, 255 - shade, 0, shade, depth } });
+        for (const std::uint16_t index : { 0, 1, 2, 0, 2, 3 })
+            scene.backToFront.push_back(static_cast<std::uint16_t>(first + index));
+    }
+    for (std::size_t layer{ s_layers }; layer-- > 0;)
+        scene.frontToBack.insert(scene.frontToBack.end(),
+                                 scene.backToFront.begin() + layer * 6,
+                                 scene.backToFront.begin() + layer * 6 + 6);
+    return scene;
+}
+
+template <typename Depth>
+static void report(std::string_view name, const Scene& scene) {
+    graphics::Canvas canvas{ s_width, s_height };
+    if constexpr (Depth::s_isEnabled) canvas.attachDepth<typename Depth::Value>();
+    using Shader = graphics::VertexColorBatchGfx;
+    Shader gfx{};
+    graphics::Rasterizer<graphics::Vertex, Shader, graphics::BlendReplace, Depth> render{ canvas,
+                                                                                        gfx };
+
+    for (const auto& [order, indices] :
+         { std::pair{ "back to front"sv, &scene.backToFront },
+           std::pair{ "front to back"sv, &scene.frontToBack } }) {
+        auto best{ std::chrono::nanoseconds::max() };
+        for (int i{}; i < s_runs; ++i) {
+            canvas.clear();
+            render.resetStats();
+            const auto start{ std::chrono::steady_clock::now() };
+            render.drawTriangles(scene.vertices, *indices);
+            const auto time{ std::chrono::steady_clock::now() - start };
+            best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(time));
+        }
+
+        const auto& stats{ render.getStats() };
+        const auto ms{ static_cast<double>(best.count()) / 1e6 };
+        std::cout << std::setw(8) << name << std::setw(16) << order << std::fixed
+                  << std::setprecision(2) << std::setw(10) << ms << std::setw(12)
+                  << stats.shadedFragments << std::setw(12) << stats.rejectedFragments
+                  << std::setw(10) << stats.rejectedBlocks << '\n';
+    }
+}
+
+int main() {
+    const auto scene{ makeScene() };
+    std::cout << "best of "sv << s_runs << " runs, "sv << s_layers << " layers, "sv << s_width
+              << 'x' << s_height << ", counts per frame\n"sv << std::setw(8) << "depth"sv
+              << std::setw(16) << "order"sv << std::setw(10) << "ms"sv << std::setw(12)
+              << "shaded"sv << std::setw(12) << "rejected"sv << std::setw(10) << "blocks"sv
+              << '\n';
+
+    report<graphics::DepthOff>("off"sv, scene);
+    report<graphics::DepthTest<std::uint16_t>>("16 bit"sv, scene);
+    report<graphics::DepthTest<std::uint32_t>>("32 bit"sv, scene);
+}
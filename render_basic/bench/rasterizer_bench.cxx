@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "../src/canvas.hxx"
+#include "../src/fragment_batch.hxx"
+#include "../src/tile_rasterizer.hxx"
+#include "../src/triangle_interpolated.hxx"
+
+using namespace std::literals;
+
+// The drawInterpolatedTriangle scene of main.cxx: two triangles covering a 1920x1080 canvas.
+static constexpr std::size_t s_width{ 1920 };
+static constexpr std::size_t s_height{ 1080 };
+static constexpr int s_runs{ 10 };
+
+// Counts shaded fragments, a pixel written twice is shaded twice.
+class CountingGfx final : public graphics::IGfx
+{
+private:
+    graphics::VertexColorGfx m_gfx{};
+
+public:
+    std::size_t fragments{};
+
+    void setUniforms(const graphics::Uniform&) override {}
+    graphics::Vertex vertexShader(const graphics::Vertex& vertex) override { return vertex; }
+    graphics::Color fragmentShader(const graphics::Vertex& vertex) override {
+        ++fragments;
+        return m_gfx.fragmentShader(vertex);
+    }
+};
+
+// The same on whole batches.
+class CountingBatchGfx final : public graphics::IBatchGfx
+{
+private:
+    graphics::VertexColorBatchGfx m_gfx{};
+
+public:
+    std::size_t fragments{};
+
+    void setUniforms(const graphics::Uniform&) override {}
+    graphics::Vertex vertexShader(const graphics::Vertex& vertex) override { return vertex; }
+    void fragmentShader(const graphics::FragmentBatch& fragments,
+                        graphics::FragmentColors& colors) override {
+        this->fragments += fragments.count();
+        m_gfx.fragmentShader(fragments, colors);
+    }
+};
+
+template <typename Render>
+static std::chrono::nanoseconds measure(graphics::Canvas& canvas, Render& render) {
+    const std::vector<graphics::Vertex> vertices{ { 0, 0, 255, 0, 0 },
+                                                  { 1919, 1079, 0, 255, 0 },
+                                                  { 0, 1079, 0, 0, 255 },
+                                                  { 1919, 0, 0, 0, 255 } };
+    const std::vector<std::uint16_t> indices{ 0, 1, 2, 0, 1, 3 };
+
+    auto best{ std::chrono::nanoseconds::max() };
+    for (int i{}; i < s_runs; ++i) {
+        canvas.clear();
+        const auto start{ std::chrono::steady_clock::now() };
+        render.drawTriangles(vertices, indices);
+        const auto time{ std::chrono::steady_clock::now() - start };
+        best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(time));
+    }
+    return best;
+}
+
+static std::size_t countWritten(const graphics::Canvas& canvas) {
+    return static_cast<std::size_t>(std::ranges::count_if(
+        canvas.getPixels(), [](graphics::Color color) { return color != graphics::Color{}; }));
+}
+
+static void report(std::string_view name,
+                   std::chrono::nanoseconds time,
+                   std::size_t fragments,
+                   std::size_t written) {
+    const auto ms{ static_cast<double>(time.count()) / 1e6 };
+    std::cout << std::setw(12) << name << std::fixed << std::setprecision(2) << std::setw(12)
+              << ms << std::setw(12) << fragments << std::setw(12) << written << std::setw(12)
+              << static_cast<double>(fragments) / ms / 1e3 << '\n';
+}
+
+int main() {
+    std::cout << "best of "sv << s_runs << " runs, "sv << s_width << 'x' << s_height << '\n'
+              << std::setw(12) << "render"sv << std::setw(12) << "ms"sv << std::setw(12)
+              << "fragments"sv << std::setw(12) << "pixels"sv << std::setw(12) << "Mfrag/s"sv
+              << '\n';
+
+    graphics::Canvas canvas{ s_width, s_height };
+
+    CountingGfx scanlineGfx{};
+    graphics::TriangleInterpolateRender scanline{ canvas, s_width, s_height, scanlineGfx };
+    const auto scanlineTime{ measure(canvas, scanline) };
+    report("scanline"sv, scanlineTime, scanlineGfx.fragments / s_runs, countWritten(canvas));
+
+    CountingGfx fixedGfx{};
+    graphics::TriangleInterpolateRender fixed{
+        canvas, s_width, s_height, fixedGfx, graphics::RasterMode::fixedPoint
+    };
+    const auto fixedTime{ measure(canvas, fixed) };
+    report("fixed"sv, fixedTime, fixedGfx.fragments / s_runs, countWritten(canvas));
+
+    CountingGfx tileGfx{};
+    graphics::TileRasterizer tile{ canvas, tileGfx };
+    const auto tileTime{ measure(canvas, tile) };
+    report("tile"sv, tileTime, tileGfx.fragments / s_runs, countWritten(canvas));
+
+    // One virtual call per batch.
+    CountingBatchGfx batchGfx{};
+    graphics::Rasterizer<graphics::Vertex, graphics::IBatchGfx> batch{ canvas, batchGfx };
+    const auto batchTime{ measure(canvas, batch) };
+    report("batch"sv, batchTime, batchGfx.fragments / s_runs, countWritten(canvas));
+
+    // The shader called directly and inlined.
+    CountingBatchGfx staticGfx{};
+    graphics::Rasterizer<graphics::Vertex, CountingBatchGfx> inlined{ canvas, staticGfx };
+    const auto staticTime{ measure(canvas, inlined) };
+    report("static"sv, staticTime, staticGfx.fragments / s_runs, countWritten(canvas));
+}
@@ -0,0 +1,127 @@
+#ifndef RENDER_BASIC_BINNED_RENDER_HXX
+#define RENDER_BASIC_BINNED_RENDER_HXX
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "canvas.hxx"
+#include "clipper.hxx"
+#include "gfx_program.hxx"
+#include "thread_pool.hxx"
+#include "tile_rasterizer.hxx"
+#include "triangle_interpolated.hxx"
+
+namespace graphics {
+
+// TileRasterizer split over threads. drawTriangles runs the vertex shader once per vertex, clips
+// and sets up every triangle once, and sorts the triangles into square bins of the screen in
+// submission order. The bins are then rasterized by the pool, every bin by one thread, so the
+// canvas needs no locks and the image is the same as TileRasterizer's for any thread count. The
+// fragment shader is called from all pool threads at once.
+class BinnedRender
+{
+public:
+    // A multiple of the rasterizer tile, so bins never split one.
+    static constexpr std::size_t s_binSize{ 64 };
+    static_assert(s_binSize % TileRasterizer::s_tileSize == 0);
+
+private:
+    Canvas& m_canvas;
+    IGfx& m_gfx;
+    ThreadPool& m_pool;
+    TileRasterizer m_rasterizer;
+    TriangleClipper<Vertex> m_clipper;
+
+    std::size_t m_binsX{};
+    std::size_t m_binsY{};
+
+    // Kept between frames, only the capacity grows.
+    std::vector<Vertex> m_vertices{};
+    std::vector<TriangleSetup<Vertex>> m_setups{};
+    std::vector<std::vector<std::uint32_t>> m_bins{};
+    std::vector<RasterStats> m_threadStats{};
+    RasterStats m_stats{};
+
+public:
+    BinnedRender(Canvas& canvas, IGfx& gfx, ThreadPool& pool)
+        : m_canvas{ canvas }, m_gfx{ gfx }, m_pool{ pool }, m_rasterizer{ canvas, gfx },
+          m_clipper{ canvas.getWidth(), canvas.getHeight(), false },
+          m_binsX{ (canvas.getWidth() + s_binSize - 1) / s_binSize },
+          m_binsY{ (canvas.getHeight() + s_binSize - 1) / s_binSize }, m_bins(m_binsX * m_binsY),
+          m_threadStats(pool.getThreadCount()) {}
+
+    // Counted over all draws since the last reset.
+    [[nodiscard]] const RasterStats& getStats() const noexcept { return m_stats; }
+    void resetStats() noexcept { m_stats = {}; }
+
+    void drawTriangles(const std::vector<Vertex>& vertices,
+                       const std::vector<std::uint16_t>& indices) {
+        if (indices.size() % 3 != 0)
+            throw std::runtime_error{ "Error : drawTriangles : indices.size() % 3 != 0"s };
+        if (std::ranges::any_of(indices, [&](std::uint16_t index) {
+                return index >= vertices.size();
+            }))
+            throw std::runtime_error{ "Error : drawTriangles : index out of range"s };
+
+        m_vertices.resize(vertices.size());
+        std::ranges::transform(
+            vertices, m_vertices.begin(), [&](const Vertex& vertex) {
+                return m_gfx.vertexShader(vertex);
+            });
+
+        m_setups.clear();
+        for (auto& bin : m_bins)
+            bin.clear();
+
+        using Result = TriangleClipper<Vertex>::Result;
+        const auto emit{ [this](const Vertex& v0, const Vertex& v1, const Vertex& v2) {
+            const auto setup{
+                TriangleSetup<Vertex>::create(v0, v1, v2, m_canvas.getWidth(), m_canvas.getHeight())
+            };
+            if (setup) addToBins(*setup);
+        } };
+        for (std::size_t i{}; i < indices.size() / 3; ++i) {
+            const auto result{ m_clipper.clip(m_vertices[indices[i * 3 + 0]],
+                                              m_vertices[indices[i * 3 + 1]],
+                                              m_vertices[indices[i * 3 + 2]],
+                                              emit) };
+            m_stats.culledTriangles += result == Result::culled;
+            m_stats.clippedTriangles += result == Result::clipped;
+        }
+
+        std::ranges::fill(m_threadStats, RasterStats{});
+        m_pool.parallelFor(m_bins.size(), [this](std::size_t bin, std::size_t thread) {
+            const auto left{ static_cast<std::int64_t>(bin % m_binsX * s_binSize) };
+            const auto top{ static_cast<std::int64_t>(bin / m_binsX * s_binSize) };
+            const auto right{ left + static_cast<std::int64_t>(s_binSize) - 1 };
+            const auto bottom{ top + static_cast<std::int64_t>(s_binSize) - 1 };
+
+            // Counted locally, the stats of neighbouring threads share a cache line.
+            RasterStats stats{};
+            for (const auto triangle : m_bins[bin])
+                m_rasterizer.rasterizeRegion(m_setups[triangle], left, top, right, bottom, stats);
+            m_threadStats[thread] += stats;
+        });
+        for (const auto& stats : m_threadStats)
+            m_stats += stats;
+    }
+
+private:
+    void addToBins(const TriangleSetup<Vertex>& setup) {
+        const auto triangle{ static_cast<std::uint32_t>(m_setups.size()) };
+        m_setups.push_back(setup);
+
+        const auto firstX{ static_cast<std::size_t>(setup.minX) / s_binSize };
+        const auto lastX{ static_cast<std::size_t>(setup.maxX) / s_binSize };
+        const auto firstY{ static_cast<std::size_t>(setup.minY) / s_binSize };
+        const auto lastY{ static_cast<std::size_t>(setup.maxY) / s_binSize };
+        for (auto binY{ firstY }; binY <= lastY; ++binY)
+            for (auto binX{ firstX }; binX <= lastX; ++binX)
+                m_bins[binY * m_binsX + binX].push_back(triangle);
+    }
+};
+
+} // namespace graphics
+
+#endif // RENDER_BASIC_BINNED_RENDER_HXX
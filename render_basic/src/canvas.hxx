@@ -6,6 +6,7 @@
 #define RENDER_BASIC_CANVAS_HXX
 
 #include <algorithm>
+#include <bit>
 #include <compare>
 #include <cstdint>
 #include <fstream>
@@ -13,17 +14,55 @@
 #include <ranges>
 #include <stdexcept>
 #include <string_view>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
+#include "depth_buffer.hxx"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace graphics {
 
 using namespace std::literals;
 
-struct Color
+// Byte order of a pixel in memory, the last byte is alpha.
+enum class PixelFormat
+{
+    rgba8,
+    bgra8
+};
+
+// One 4 byte pixel, the layout canvases store and present without conversion. The channel order
+// is RGBA8, or BGRA8 when built with RENDER_BASIC_BGRA. Alpha is opaque unless given.
+struct alignas(4) Color
 {
+#if defined(RENDER_BASIC_BGRA)
+    static constexpr PixelFormat s_format{ PixelFormat::bgra8 };
+
+    std::uint8_t blue{};
+    std::uint8_t green{};
+    std::uint8_t red{};
+#else
+    static constexpr PixelFormat s_format{ PixelFormat::rgba8 };
+
     std::uint8_t red{};
     std::uint8_t green{};
     std::uint8_t blue{};
+#endif
+    std::uint8_t alpha{ 255 };
+
+    constexpr Color() noexcept = default;
+    constexpr Color(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a = 255) noexcept {
+        red = r;
+        green = g;
+        blue = b;
+        alpha = a;
+    }
 
     auto operator<=>(const Color& color) const = default;
 
@@ -38,17 +77,41 @@ inline constexpr Color red{ 255, 0, 0 };
 inline constexpr Color green{ 0, 255, 0 };
 inline constexpr Color blue{ 0, 0, 255 };
 
-using Pixels = std::vector<Color>;
+static_assert(sizeof(Color) == 4);
 
-static std::ofstream& operator<<(std::ofstream& out, const Pixels& pixels) {
-    out.write(reinterpret_cast<const char*>(pixels.data()),
-              pixels.size() * sizeof(Pixels::value_type));
-    return out;
-}
+using Pixels = std::vector<Color>;
 
-static std::ifstream& operator>>(std::ifstream& in, Pixels& pixels) {
-    in.read(reinterpret_cast<char*>(pixels.data()), pixels.size() * sizeof(Pixels::value_type));
-    return in;
+// Writes count copies of color from first on, 16 bytes per store. With isStreaming and SSE2 the
+// stores are non-temporal and go straight to memory. NEON has no such store, it fills through
+// the caches.
+inline void fillColors(Color* first, std::size_t count, Color color, bool isStreaming) noexcept {
+#if defined(__SSE2__)
+    while (count > 0 && std::bit_cast<std::uintptr_t>(first) % 16 != 0) {
+        *first++ = color;
+        --count;
+    }
+    const __m128i value{ _mm_set1_epi32(std::bit_cast<std::int32_t>(color)) };
+    auto* vectors{ reinterpret_cast<__m128i*>(first) };
+    const auto vectorCount{ count / 4 };
+    if (isStreaming) {
+        for (std::size_t i{}; i < vectorCount; ++i)
+            _mm_stream_si128(vectors + i, value);
+        _mm_sfence();
+    }
+    else
+        for (std::size_t i{}; i < vectorCount; ++i)
+            _mm_store_si128(vectors + i, value);
+    first += vectorCount * 4;
+    count -= vectorCount * 4;
+#elif defined(__ARM_NEON)
+    (void)isStreaming;
+    const uint32x4_t value{ vdupq_n_u32(std::bit_cast<std::uint32_t>(color)) };
+    for (; count >= 4; count -= 4, first += 4)
+        vst1q_u32(reinterpret_cast<std::uint32_t*>(first), value);
+#else
+    (void)isStreaming;
+#endif
+    std::fill_n(first, count, color);
 }
 
 struct Position
@@ -76,22 +139,53 @@ static double distance(Position p1, Position p2) {
     return std::hypot(static_cast<double>(p1.x) - p2.x, static_cast<double>(p1.y) - p2.y);
 }
 
+// Pixels are stored in rows of getPitch() pixels, the width rounded up to the row alignment given
+// at construction; the pixels past the width are padding, cleared with the rest and never drawn.
+// A row alignment of 16 pixels makes every row a whole number of 64 byte vectors, so SIMD code
+// can store whole vectors up to the end of every row. The rows start at the alignment of the
+// buffer, which is a plain std::vector: 16 bytes, not a cache line. Images are saved and loaded
+// as 24 bit PPM.
+//
+// Spans, rectangles and blits are filled and copied a row at a time, never pixel by pixel; they
+// throw if they do not fit in the canvas.
 class Canvas
 {
+public:
+    // Fills above this size bypass the caches, the pixels would evict everything else before
+    // they are read back.
+    static constexpr std::size_t s_streamingFillBytes{ 1 << 20 };
+
 private:
     std::size_t m_width{};
     std::size_t m_height{};
+    std::size_t m_rowAlignment{ 1 };
+    std::size_t m_pitch{};
     Pixels m_pixels{};
+    std::variant<std::monostate, DepthBuffer16, DepthBuffer32> m_depth{};
 
 public:
-    Canvas(std::size_t width, std::size_t height)
-        : m_width{ width }, m_height{ height }, m_pixels(m_width * m_height) {}
+    Canvas(std::size_t width, std::size_t height, std::size_t rowAlignment = 1)
+        : m_width{ width }, m_height{ height }, m_rowAlignment{ rowAlignment },
+          m_pitch{ getAlignedPitch() }, m_pixels(m_pitch * m_height) {
+        if (rowAlignment == 0)
+            throw std::runtime_error{ "Error : Canvas : rowAlignment == 0"s };
+    }
 
     void saveImage(std::string_view filename) {
         std::ofstream out{ filename.data(), std::ios::binary };
         out.exceptions(std::ios::failbit);
         out << "P6\n"sv << m_width << ' ' << m_height << '\n' << 255 << '\n';
-        out << m_pixels;
+
+        std::vector<char> bytes(m_width * 3);
+        for (std::size_t y{}; y < m_height; ++y) {
+            const Color* row{ getRow(y) };
+            for (std::size_t x{}; x < m_width; ++x) {
+                bytes[x * 3 + 0] = static_cast<char>(row[x].red);
+                bytes[x * 3 + 1] = static_cast<char>(row[x].green);
+                bytes[x * 3 + 2] = static_cast<char>(row[x].blue);
+            }
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        }
     }
 
     void loadImage(std::string_view filename) {
@@ -104,29 +198,112 @@ public:
         if (!std::iswspace(ws))
             throw std::runtime_error{ "Error : loadImage : bad load image from file"s };
 
-        m_pixels.resize(m_width * m_height);
-        in >> m_pixels;
+        m_pitch = getAlignedPitch();
+        m_pixels.assign(m_pitch * m_height, Color{});
+        std::vector<char> bytes(m_width * 3);
+        for (std::size_t y{}; y < m_height; ++y) {
+            in.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            Color* row{ getRow(y) };
+            for (std::size_t x{}; x < m_width; ++x)
+                row[x] = { static_cast<std::uint8_t>(bytes[x * 3 + 0]),
+                           static_cast<std::uint8_t>(bytes[x * 3 + 1]),
+                           static_cast<std::uint8_t>(bytes[x * 3 + 2]) };
+        }
+        std::visit(
+            [this]<typename Depth>(Depth& depth) {
+                if constexpr (!std::is_same_v<Depth, std::monostate>)
+                    depth = Depth{ m_width, m_height };
+            },
+            m_depth);
     }
 
-    void setPixel(Position position, Color color) {
-        m_pixels.at(position.y * m_width + position.x) = color;
-    }
+    void setPixel(Position position, Color color) { m_pixels.at(getIndex(position)) = color; }
 
     [[nodiscard]] Color getPixel(Position position) const noexcept {
-        return m_pixels.at(position.y * m_width + position.x);
+        return m_pixels.at(getIndex(position));
+    }
+
+    // The first pixel of row y, unchecked.
+    [[nodiscard]] Color* getRow(std::size_t y) noexcept { return m_pixels.data() + y * m_pitch; }
+    [[nodiscard]] const Color* getRow(std::size_t y) const noexcept {
+        return m_pixels.data() + y * m_pitch;
+    }
+
+    // A row of length pixels from position to the right.
+    void fillSpan(Position position, std::size_t length, Color color) {
+        if (position.y >= m_height || position.x > m_width || length > m_width - position.x)
+            throw std::runtime_error{ "Error : fillSpan : span out of canvas"s };
+        fillColors(getRow(position.y) + position.x, length, color, false);
+    }
+
+    void fillRect(Position topLeft, std::size_t width, std::size_t height, Color color) {
+        if (topLeft.x > m_width || width > m_width - topLeft.x || topLeft.y > m_height ||
+            height > m_height - topLeft.y)
+            throw std::runtime_error{ "Error : fillRect : rect out of canvas"s };
+
+        const bool isStreaming{ width * height * sizeof(Color) >= s_streamingFillBytes };
+        for (auto y{ topLeft.y }; y < topLeft.y + height; ++y)
+            fillColors(getRow(y) + topLeft.x, width, color, isStreaming);
+    }
+
+    // Copies the pixels of source with its top left pixel at position.
+    void blit(const Canvas& source, Position position) {
+        if (position.x > m_width || source.m_width > m_width - position.x ||
+            position.y > m_height || source.m_height > m_height - position.y)
+            throw std::runtime_error{ "Error : blit : source out of canvas"s };
+
+        for (std::size_t y{}; y < source.m_height; ++y)
+            std::copy_n(source.getRow(y), source.m_width, getRow(position.y + y) + position.x);
+    }
+
+    // Clears the colour and, if attached, the depth to the far plane.
+    void clear(Color color = {}) {
+        fillColors(m_pixels.data(),
+                   m_pixels.size(),
+                   color,
+                   m_pixels.size() * sizeof(Color) >= s_streamingFillBytes);
+        std::visit(
+            []<typename Depth>(Depth& depth) {
+                if constexpr (!std::is_same_v<Depth, std::monostate>) depth.clear();
+            },
+            m_depth);
     }
 
-    void clear(Color color = {}) { std::ranges::fill(m_pixels, color); }
+    // Replaces the depth attachment with a cleared one of the given format.
+    template <typename T>
+    void attachDepth() {
+        m_depth.emplace<DepthBuffer<T>>(m_width, m_height);
+    }
+
+    // Nothing if no depth of this format is attached.
+    template <typename T>
+    [[nodiscard]] DepthBuffer<T>* getDepth() noexcept {
+        return std::get_if<DepthBuffer<T>>(&m_depth);
+    }
 
+    // All rows with their padding.
     [[nodiscard]] const Pixels& getPixels() const noexcept { return m_pixels; }
     [[nodiscard]] Pixels& getPixels() noexcept { return m_pixels; }
     [[nodiscard]] std::size_t getWidth() const noexcept { return m_width; }
     [[nodiscard]] std::size_t getHeight() const noexcept { return m_height; }
+    // In pixels, the row size in bytes is getPitch() * sizeof(Color).
+    [[nodiscard]] std::size_t getPitch() const noexcept { return m_pitch; }
 
     [[nodiscard]] auto begin() { return m_pixels.begin(); }
     [[nodiscard]] auto end() { return m_pixels.end(); }
 
     auto operator<=>(const Canvas& canvas) const = default;
+
+private:
+    // Past the end of the pixels for x off the canvas, so .at() rejects the row padding too.
+    [[nodiscard]] std::size_t getIndex(Position position) const noexcept {
+        return position.x < m_width ? position.y * m_pitch + position.x : m_pixels.size();
+    }
+
+    [[nodiscard]] std::size_t getAlignedPitch() const noexcept {
+        if (m_rowAlignment == 0) return m_width;
+        return (m_width + m_rowAlignment - 1) / m_rowAlignment * m_rowAlignment;
+    }
 };
 
 using PixelPositions = std::vector<Position>;
@@ -0,0 +1,172 @@
+#ifndef RENDER_BASIC_CLIPPER_HXX
+#define RENDER_BASIC_CLIPPER_HXX
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "pipeline_state.hxx"
+
+namespace graphics {
+
+// Culls and clips triangles before rasterization.
+//
+// Vertices reach the rasterizer in pixels with w = 1, render_basic has no projection, so the
+// homogeneous clip planes are x, y against the guard band and, for depth tested pipelines, z
+// against the near (0) and far (1) planes. The guard band is a wide frame around the canvas:
+// triangles inside it are rasterized as they are, the bounding box clamp of the setup keeps them
+// on the canvas. Only the rare triangles reaching past it are clipped, so the fixed-point edge
+// functions never overflow and ordinary partly visible triangles keep their exact coverage.
+// Triangles entirely on the outer side of one canvas edge or depth plane, or with a vertex that
+// is not finite, are culled without setup.
+template <typename VertexT>
+class TriangleClipper
+{
+public:
+    // In pixels on every side of the canvas. Edge function values stay below 2^52.
+    static constexpr double s_guardBand{ 1 << 16 };
+
+    enum class Result
+    {
+        culled,
+        inside,
+        clipped
+    };
+
+private:
+    enum Plane : std::uint32_t
+    {
+        left,
+        right,
+        top,
+        bottom,
+        depthNear,
+        depthFar,
+        planeCount
+    };
+
+    // Every plane adds at most one vertex to the polygon.
+    static constexpr std::size_t s_maxVertices{ 3 + planeCount };
+
+    using Polygon = std::array<VertexT, s_maxVertices>;
+
+    double m_maxX{};
+    double m_maxY{};
+    bool m_isDepthClipped{};
+
+public:
+    TriangleClipper(std::size_t width, std::size_t height, bool isDepthClipped)
+        : m_maxX{ static_cast<double>(width) - 1 }, m_maxY{ static_cast<double>(height) - 1 },
+          m_isDepthClipped{ isDepthClipped } {
+        if (isDepthClipped && !VertexTraits<VertexT>::s_hasDepth)
+            throw std::runtime_error{ "Error : TriangleClipper : no depth to clip"s };
+    }
+
+    // Calls emit(v0, v1, v2) for every visible piece of the triangle: once with the triangle
+    // itself if it needs no clipping, for every triangle of the clipped polygon otherwise.
+    template <typename Emit>
+    Result clip(const VertexT& v0, const VertexT& v1, const VertexT& v2, Emit&& emit) const {
+        if (!isFinite(v0) || !isFinite(v1) || !isFinite(v2)) return Result::culled;
+        const auto codes{ getViewportCodes(v0) & getViewportCodes(v1) & getViewportCodes(v2) };
+        if (codes != 0) return Result::culled;
+
+        const auto guardCodes{ getClipCodes(v0) | getClipCodes(v1) | getClipCodes(v2) };
+        if (guardCodes == 0) {
+            emit(v0, v1, v2);
+            return Result::inside;
+        }
+
+        Polygon polygon{ v0, v1, v2 };
+        Polygon clipped{};
+        std::size_t count{ 3 };
+        for (std::uint32_t plane{}; plane < planeCount && count >= 3; ++plane) {
+            if ((guardCodes >> plane & 1u) == 0) continue;
+            count = clipPolygon(polygon, count, static_cast<Plane>(plane), clipped);
+            std::swap(polygon, clipped);
+        }
+        if (count < 3) return Result::culled;
+
+        for (std::size_t i{ 1 }; i + 1 < count; ++i)
+            emit(polygon[0], polygon[i], polygon[i + 1]);
+        return Result::clipped;
+    }
+
+private:
+    // Signed distance in pixels or depth units, negative outside. The x and y planes are those
+    // of the guard band.
+    [[nodiscard]] double getDistance(const VertexT& vertex, Plane plane) const noexcept {
+        switch (plane) {
+        case left:
+            return vertex.x + s_guardBand;
+        case right:
+            return m_maxX + s_guardBand - vertex.x;
+        case top:
+            return vertex.y + s_guardBand;
+        case bottom:
+            return m_maxY + s_guardBand - vertex.y;
+        case depthNear:
+            if constexpr (VertexTraits<VertexT>::s_hasDepth)
+                return VertexTraits<VertexT>::getDepth(vertex);
+            return 0.0;
+        case depthFar:
+            if constexpr (VertexTraits<VertexT>::s_hasDepth)
+                return 1.0 - VertexTraits<VertexT>::getDepth(vertex);
+            return 0.0;
+        default:
+            return 0.0;
+        }
+    }
+
+    // The planes the vertex is outside of, the x and y planes at the canvas edges.
+    [[nodiscard]] std::uint32_t getViewportCodes(const VertexT& vertex) const noexcept {
+        std::uint32_t codes{ static_cast<std::uint32_t>(vertex.x < 0.0) << left |
+                             static_cast<std::uint32_t>(vertex.x > m_maxX) << right |
+                             static_cast<std::uint32_t>(vertex.y < 0.0) << top |
+                             static_cast<std::uint32_t>(vertex.y > m_maxY) << bottom };
+        return codes | getDepthCodes(vertex);
+    }
+
+    // The planes the vertex is outside of, the x and y planes at the guard band.
+    [[nodiscard]] std::uint32_t getClipCodes(const VertexT& vertex) const noexcept {
+        std::uint32_t codes{};
+        for (const auto plane : { left, right, top, bottom })
+            codes |= static_cast<std::uint32_t>(getDistance(vertex, plane) < 0.0) << plane;
+        return codes | getDepthCodes(vertex);
+    }
+
+    [[nodiscard]] std::uint32_t getDepthCodes(const VertexT& vertex) const noexcept {
+        if (!m_isDepthClipped) return 0;
+        return static_cast<std::uint32_t>(getDistance(vertex, depthNear) < 0.0) << depthNear |
+               static_cast<std::uint32_t>(getDistance(vertex, depthFar) < 0.0) << depthFar;
+    }
+
+    [[nodiscard]] static bool isFinite(const VertexT& vertex) noexcept {
+        if constexpr (VertexTraits<VertexT>::s_hasDepth)
+            if (!std::isfinite(VertexTraits<VertexT>::getDepth(vertex))) return false;
+        return std::isfinite(vertex.x) && std::isfinite(vertex.y);
+    }
+
+    // Sutherland-Hodgman against one plane, returns the vertex count of the result.
+    [[nodiscard]] std::size_t
+    clipPolygon(const Polygon& polygon, std::size_t count, Plane plane, Polygon& result) const {
+        std::size_t resultCount{};
+        for (std::size_t i{}; i < count; ++i) {
+            const auto& current{ polygon[i] };
+            const auto& next{ polygon[(i + 1) % count] };
+            const double currentDistance{ getDistance(current, plane) };
+            const double nextDistance{ getDistance(next, plane) };
+
+            if (currentDistance >= 0.0) result[resultCount++] = current;
+            if ((currentDistance >= 0.0) != (nextDistance >= 0.0)) {
+                const double t{ currentDistance / (currentDistance - nextDistance) };
+                result[resultCount++] = VertexTraits<VertexT>::lerp(current, next, t);
+            }
+        }
+        return resultCount;
+    }
+};
+
+} // namespace graphics
+
+#endif // RENDER_BASIC_CLIPPER_HXX
@@ -0,0 +1,96 @@
+#ifndef RENDER_BASIC_DEPTH_BUFFER_HXX
+#define RENDER_BASIC_DEPTH_BUFFER_HXX
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace graphics {
+
+// Depth attachment of a canvas, 16 or 32 bit unsigned normalized: 0 is the nearest depth, the
+// maximum value the farthest. Every aligned 8x8 block also keeps the minimum and the maximum
+// depth stored in it, so the rasterizer can test a whole tile against them before shading it.
+template <typename T>
+    requires std::same_as<T, std::uint16_t> || std::same_as<T, std::uint32_t>
+class DepthBuffer
+{
+public:
+    using Value = T;
+
+    static constexpr std::size_t s_blockSize{ 8 };
+    static constexpr T s_far{ std::numeric_limits<T>::max() };
+
+private:
+    std::size_t m_width{};
+    std::size_t m_height{};
+    std::size_t m_blocksX{};
+    std::vector<T> m_values{};
+    std::vector<T> m_blockMin{};
+    std::vector<T> m_blockMax{};
+
+public:
+    DepthBuffer(std::size_t width, std::size_t height)
+        : m_width{ width }, m_height{ height },
+          m_blocksX{ (width + s_blockSize - 1) / s_blockSize }, m_values(width * height, s_far),
+          m_blockMin(m_blocksX * ((height + s_blockSize - 1) / s_blockSize), s_far),
+          m_blockMax(m_blockMin.size(), s_far) {}
+
+    // Depth in [0, 1] to the stored value, rounded to nearest. Values outside are clamped.
+    [[nodiscard]] static T quantize(double depth) noexcept {
+        const double clamped{ std::clamp(depth, 0.0, 1.0) };
+        return static_cast<T>(clamped * static_cast<double>(s_far) + 0.5);
+    }
+
+    void clear(T value = s_far) {
+        std::ranges::fill(m_values, value);
+        std::ranges::fill(m_blockMin, value);
+        std::ranges::fill(m_blockMax, value);
+    }
+
+    [[nodiscard]] T* getRow(std::size_t y) noexcept { return m_values.data() + y * m_width; }
+    [[nodiscard]] const T* getRow(std::size_t y) const noexcept {
+        return m_values.data() + y * m_width;
+    }
+
+    [[nodiscard]] T getBlockMin(std::size_t blockX, std::size_t blockY) const noexcept {
+        return m_blockMin[blockY * m_blocksX + blockX];
+    }
+    [[nodiscard]] T getBlockMax(std::size_t blockX, std::size_t blockY) const noexcept {
+        return m_blockMax[blockY * m_blocksX + blockX];
+    }
+
+    // Recomputes the range of a block after its values were written.
+    void updateBlock(std::size_t blockX, std::size_t blockY) noexcept {
+        const auto left{ blockX * s_blockSize };
+        const auto top{ blockY * s_blockSize };
+        const auto right{ std::min(left + s_blockSize, m_width) };
+        const auto bottom{ std::min(top + s_blockSize, m_height) };
+
+        T low{ s_far };
+        T high{};
+        for (auto y{ top }; y < bottom; ++y) {
+            const auto [rowLow, rowHigh]{
+                std::minmax_element(getRow(y) + left, getRow(y) + right)
+            };
+            low = std::min(low, *rowLow);
+            high = std::max(high, *rowHigh);
+        }
+        m_blockMin[blockY * m_blocksX + blockX] = low;
+        m_blockMax[blockY * m_blocksX + blockX] = high;
+    }
+
+    [[nodiscard]] const std::vector<T>& getValues() const noexcept { return m_values; }
+    [[nodiscard]] std::size_t getWidth() const noexcept { return m_width; }
+    [[nodiscard]] std::size_t getHeight() const noexcept { return m_height; }
+
+    auto operator<=>(const DepthBuffer& depth) const = default;
+};
+
+using DepthBuffer16 = DepthBuffer<std::uint16_t>;
+using DepthBuffer32 = DepthBuffer<std::uint32_t>;
+
+} // namespace graphics
+
+#endif // RENDER_BASIC_DEPTH_BUFFER_HXX
@@ -0,0 +1,144 @@
+#ifndef RENDER_BASIC_FRAGMENT_BATCH_HXX
+#define RENDER_BASIC_FRAGMENT_BATCH_HXX
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#include "canvas.hxx"
+#include "gfx_program.hxx"
+#include "vertex.hxx"
+
+#if defined(__AVX2__)
+#    include <immintrin.h>
+#elif defined(__ARM_NEON)
+#    include <arm_neon.h>
+#endif
+
+namespace graphics {
+
+// One row of a rasterizer tile: 8 horizontally adjacent fragments in structure-of-arrays form.
+// Lanes whose bit is clear in mask are not covered, their values are unspecified and their
+// colours are not written.
+struct FragmentBatch
+{
+    static constexpr std::size_t s_lanes{ 8 };
+
+    alignas(32) std::array<float, s_lanes> x{};
+    alignas(32) std::array<float, s_lanes> y{};
+    alignas(32) std::array<float, s_lanes> r{};
+    alignas(32) std::array<float, s_lanes> g{};
+    alignas(32) std::array<float, s_lanes> b{};
+    std::uint32_t mask{};
+
+    [[nodiscard]] bool isCovered(std::size_t lane) const noexcept {
+        return (mask >> lane & 1u) != 0;
+    }
+    [[nodiscard]] std::size_t count() const noexcept {
+        return static_cast<std::size_t>(std::popcount(mask));
+    }
+};
+
+using FragmentColors = std::array<Color, FragmentBatch::s_lanes>;
+
+// Shader working on whole fragment batches, one virtual call per 8 fragments. A final class
+// passed to Rasterizer by its own type is called without virtual dispatch and inlined.
+class IBatchGfx
+{
+public:
+    virtual ~IBatchGfx() = default;
+    virtual void setUniforms(const Uniform& uniform) = 0;
+    virtual Vertex vertexShader(const Vertex& vertex) = 0;
+    virtual void fragmentShader(const FragmentBatch& fragments, FragmentColors& colors) = 0;
+};
+
+// Runs a per-fragment IGfx on batches, one call per covered lane.
+class GfxBatchAdapter final : public IBatchGfx
+{
+private:
+    IGfx& m_gfx;
+
+public:
+    explicit GfxBatchAdapter(IGfx& gfx) : m_gfx{ gfx } {}
+
+    void setUniforms(const Uniform& uniform) override { m_gfx.setUniforms(uniform); }
+    Vertex vertexShader(const Vertex& vertex) override { return m_gfx.vertexShader(vertex); }
+    void fragmentShader(const FragmentBatch& fragments, FragmentColors& colors) override {
+        for (std::size_t lane{}; lane < FragmentBatch::s_lanes; ++lane)
+            if (fragments.isCovered(lane))
+                colors[lane] = m_gfx.fragmentShader({ fragments.x[lane],
+                                                      fragments.y[lane],
+                                                      fragments.r[lane],
+                                                      fragments.g[lane],
+                                                      fragments.b[lane] });
+    }
+};
+
+// Draws the interpolated vertex colours as they are.
+class VertexColorBatchGfx final : public IBatchGfx
+{
+public:
+    void setUniforms(const Uniform&) override {}
+    Vertex vertexShader(const Vertex& vertex) override { return vertex; }
+    void fragmentShader(const FragmentBatch& fragments, FragmentColors& colors) override {
+        for (std::size_t lane{}; lane < FragmentBatch::s_lanes; ++lane)
+            colors[lane] = { static_cast<std::uint8_t>(fragments.r[lane]),
+                             static_cast<std::uint8_t>(fragments.g[lane]),
+                             static_cast<std::uint8_t>(fragments.b[lane]) };
+    }
+};
+
+// Lanes with value + stepX * lane >= minValue, for an integer edge function.
+[[nodiscard]] inline std::uint32_t
+coverLanes(std::int64_t value, std::int64_t stepX, std::int64_t minValue) noexcept {
+#if defined(__AVX2__)
+    const __m256i threshold{ _mm256_set1_epi64x(minValue - 1) };
+    const __m256i low{ _mm256_add_epi64(
+        _mm256_set1_epi64x(value), _mm256_set_epi64x(stepX * 3, stepX * 2, stepX, 0)) };
+    const __m256i high{ _mm256_add_epi64(low, _mm256_set1_epi64x(stepX * 4)) };
+    const auto lowMask{ _mm256_movemask_pd(
+        _mm256_castsi256_pd(_mm256_cmpgt_epi64(low, threshold))) };
+    const auto highMask{ _mm256_movemask_pd(
+        _mm256_castsi256_pd(_mm256_cmpgt_epi64(high, threshold))) };
+    return static_cast<std::uint32_t>(lowMask | highMask << 4);
+#elif defined(__ARM_NEON)
+    const int64x2_t threshold{ vdupq_n_s64(minValue) };
+    const int64x2_t step{ vdupq_n_s64(stepX * 2) };
+    int64x2_t values{ vaddq_s64(vdupq_n_s64(value), int64x2_t{ 0, stepX }) };
+    std::uint32_t mask{};
+    for (std::uint32_t pair{}; pair < FragmentBatch::s_lanes / 2; ++pair) {
+        const uint64x2_t isCovered{ vcgeq_s64(values, threshold) };
+        mask |= static_cast<std::uint32_t>(vgetq_lane_u64(isCovered, 0) & 1u) << pair * 2;
+        mask |= static_cast<std::uint32_t>(vgetq_lane_u64(isCovered, 1) & 1u) << (pair * 2 + 1);
+        values = vaddq_s64(values, step);
+    }
+    return mask;
+#else
+    std::uint32_t mask{};
+    for (std::uint32_t lane{}; lane < FragmentBatch::s_lanes; ++lane, value += stepX)
+        mask |= static_cast<std::uint32_t>(value >= minValue) << lane;
+    return mask;
+#endif
+}
+
+// Writes start + step * lane into the lanes.
+inline void interpolateLanes(std::array<float, FragmentBatch::s_lanes>& lanes,
+                             float start,
+                             float step) noexcept {
+#if defined(__AVX2__)
+    const __m256 index{ _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f) };
+    const __m256 offsets{ _mm256_mul_ps(_mm256_set1_ps(step), index) };
+    _mm256_store_ps(lanes.data(), _mm256_add_ps(_mm256_set1_ps(start), offsets));
+#elif defined(__ARM_NEON)
+    const float32x4_t low{ 0.0f, 1.0f, 2.0f, 3.0f };
+    const float32x4_t high{ 4.0f, 5.0f, 6.0f, 7.0f };
+    vst1q_f32(lanes.data(), vaddq_f32(vdupq_n_f32(start), vmulq_n_f32(low, step)));
+    vst1q_f32(lanes.data() + 4, vaddq_f32(vdupq_n_f32(start), vmulq_n_f32(high, step)));
+#else
+    for (std::size_t lane{}; lane < FragmentBatch::s_lanes; ++lane)
+        lanes[lane] = start + step * static_cast<float>(lane);
+#endif
+}
+
+} // namespace graphics
+
+#endif // RENDER_BASIC_FRAGMENT_BATCH_HXX
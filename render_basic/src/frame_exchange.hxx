@@ -0,0 +1,89 @@
+#ifndef RENDER_BASIC_FRAME_EXCHANGE_HXX
+#define RENDER_BASIC_FRAME_EXCHANGE_HXX
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace graphics {
+
+// Hands whole frames from one producer thread to one consumer thread without locks. There are
+// three slots: the producer writes the back one, the consumer reads the front one, and the third
+// holds the latest published frame. Publishing and taking a frame each swap one slot index with
+// a single atomic word, so neither side ever sees a frame the other is still touching.
+//
+// A producer that must not run ahead, like a renderer, calls waitTaken() after publish(): it then
+// draws frame N + 1 while the consumer shows frame N, and never draws a frame nobody shows. One
+// that may, like the input feeding uniforms to the renderer, just publishes and the consumer
+// takes the latest. close() wakes a waiting producer for good.
+template <typename T>
+class FrameExchange
+{
+private:
+    static constexpr std::uint32_t s_indexMask{ 0b11 };
+    static constexpr std::uint32_t s_isFresh{ 0b100 };
+    static constexpr std::uint32_t s_isClosed{ 0b1000 };
+
+    std::array<T, 3> m_slots;
+    // The slot of the latest frame, whether the consumer has taken it, whether closed.
+    std::atomic<std::uint32_t> m_latest{ 2 };
+    std::uint32_t m_back{ 0 };  // the producer's
+    std::uint32_t m_front{ 1 }; // the consumer's
+
+public:
+    // Every slot starts as a copy of value.
+    explicit FrameExchange(const T& value = T{}) : m_slots{ value, value, value } {}
+
+    FrameExchange(const FrameExchange&) = delete;
+    FrameExchange& operator=(const FrameExchange&) = delete;
+
+    // Producer side.
+    [[nodiscard]] T& getBack() noexcept { return m_slots[m_back]; }
+
+    // Makes the back slot the latest frame, a frame published before and not taken is dropped.
+    void publish() noexcept {
+        auto latest{ m_latest.load(std::memory_order_relaxed) };
+        while (!m_latest.compare_exchange_weak(latest,
+                                               (latest & s_isClosed) | m_back | s_isFresh,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_relaxed)) {}
+        m_back = latest & s_indexMask;
+    }
+
+    // Blocks until the consumer took the latest frame or the exchange was closed.
+    void waitTaken() const noexcept {
+        auto latest{ m_latest.load(std::memory_order_acquire) };
+        while ((latest & s_isFresh) != 0 && (latest & s_isClosed) == 0) {
+            m_latest.wait(latest, std::memory_order_acquire);
+            latest = m_latest.load(std::memory_order_acquire);
+        }
+    }
+
+    // Consumer side. Takes the latest frame into the front slot, false if there is no new one.
+    bool acquire() noexcept {
+        auto latest{ m_latest.load(std::memory_order_relaxed) };
+        do {
+            if ((latest & s_isFresh) == 0) return false;
+        } while (!m_latest.compare_exchange_weak(latest,
+                                                 (latest & s_isClosed) | m_front,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_relaxed));
+        m_front = latest & s_indexMask;
+        m_latest.notify_one();
+        return true;
+    }
+
+    [[nodiscard]] const T& getFront() const noexcept { return m_slots[m_front]; }
+
+    void close() noexcept {
+        m_latest.fetch_or(s_isClosed, std::memory_order_acq_rel);
+        m_latest.notify_all();
+    }
+
+    [[nodiscard]] bool isClosed() const noexcept {
+        return (m_latest.load(std::memory_order_acquire) & s_isClosed) != 0;
+    }
+};
+
+} // namespace graphics
+
+#endif // RENDER_BASIC_FRAME_EXCHANGE_HXX
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cmath>
 #include <ranges>
+#include <stdexcept>
 
 #include "canvas.hxx"
 
@@ -66,10 +67,59 @@ public:
         return positions;
     }
 
+    // The pixels of pixelPositions, written without building them: a line closer to horizontal
+    // as one span per row, a steeper one a pixel per row.
     void drawLine(Position start, Position end, Color color) {
-        auto positions{ pixelPositions(start, end) };
-        std::ranges::for_each(positions,
-                              [&](const Position position) { m_canvas.setPixel(position, color); });
+        const auto width{ m_canvas.getWidth() };
+        const auto height{ m_canvas.getHeight() };
+        if (start.x >= width || start.y >= height || end.x >= width || end.y >= height)
+            throw std::runtime_error{ "Error : drawLine : position out of canvas"s };
+
+        auto x0{ static_cast<std::int64_t>(start.x) };
+        auto y0{ static_cast<std::int64_t>(start.y) };
+        const auto x1{ static_cast<std::int64_t>(end.x) };
+        const auto y1{ static_cast<std::int64_t>(end.y) };
+
+        const std::int64_t dx{ std::abs(x1 - x0) };
+        const std::int64_t dy{ std::abs(y1 - y0) };
+
+        const int sx{ x0 < x1 ? 1 : -1 };
+        const int sy{ y0 < y1 ? 1 : -1 };
+
+        // The end points are on the canvas, so is every run between them.
+        const auto fillRun{ [&](std::int64_t from, std::int64_t to, std::int64_t y) {
+            const auto left{ static_cast<std::size_t>(std::min(from, to)) };
+            const auto length{ static_cast<std::size_t>(std::abs(to - from) + 1) };
+            fillColors(m_canvas.getRow(static_cast<std::size_t>(y)) + left, length, color, false);
+        } };
+
+        std::int64_t error{ dx > dy ? dx : dy };
+        if (dx > dy) {
+            auto runStart{ x0 };
+            while (x0 != x1) {
+                x0 += sx;
+                error -= 2 * dy;
+                if (error < 0) {
+                    fillRun(runStart, x0 - sx, y0);
+                    runStart = x0;
+                    y0 += sy;
+                    error += 2 * dx;
+                }
+            }
+            fillRun(runStart, x0, y0);
+        }
+        else {
+            while (y0 != y1) {
+                m_canvas.getRow(static_cast<std::size_t>(y0))[x0] = color;
+                y0 += sy;
+                error -= 2 * dx;
+                if (error < 0) {
+                    x0 += sx;
+                    error += 2 * dy;
+                }
+            }
+            m_canvas.getRow(static_cast<std::size_t>(y0))[x0] = color;
+        }
     }
 };
 
@@ -46,7 +46,8 @@ void drawInterpolatedTriangle() {
 
     graphics::Canvas canvas{ w, h };
     canvas.clear({});
-    graphics::TriangleInterpolateRender render{ canvas, 1920, 1080 };
+    graphics::VertexColorGfx gfx{};
+    graphics::TriangleInterpolateRender render{ canvas, 1920, 1080, gfx };
     graphics::Vertex v0{ 0, 0, 255, 0, 0 };
     graphics::Vertex v1{ 1919, 1079, 0, 255, 0 };
     graphics::Vertex v2{ 0, 1079, 0, 0, 255 };
@@ -78,7 +79,8 @@ void drawCircle() {
     std::vector<std::uint16_t> indicesBuffer = createCircleIndices(60);
 
     graphics::Canvas canvas{ 1920, 1080 };
-    graphics::TriangleInterpolateRender render{ canvas, 1920, 1080 };
+    graphics::VertexColorGfx gfx{};
+    graphics::TriangleInterpolateRender render{ canvas, 1920, 1080, gfx };
     render.drawTriangles(verticesBuffer, indicesBuffer);
     canvas.saveImage("circle.ppm");
 }
@@ -0,0 +1,196 @@
+#ifndef RENDER_BASIC_PIPELINE_STATE_HXX
+#define RENDER_BASIC_PIPELINE_STATE_HXX
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "canvas.hxx"
+#include "depth_buffer.hxx"
+#include "fragment_batch.hxx"
+#include "vertex.hxx"
+
+namespace graphics {
+
+// Vertex without attributes, for shaders that colour fragments by their position only.
+struct PositionVertex
+{
+    double x{};
+    double y{};
+};
+
+// The attributes of a vertex type the rasterizer interpolates, and the batch lanes they go to.
+// Every vertex type has x and y, a batch carries up to three attributes. Depth testing needs a
+// vertex type with depth. lerp blends two vertices for the clipper.
+template <typename VertexT>
+struct VertexTraits;
+
+template <>
+struct VertexTraits<Vertex>
+{
+    static constexpr std::size_t s_attributeCount{ 3 };
+    static constexpr bool s_hasDepth{ true };
+
+    [[nodiscard]] static std::array<double, 3> getAttributes(const Vertex& vertex) noexcept {
+        return { vertex.r, vertex.g, vertex.b };
+    }
+
+    [[nodiscard]] static double getDepth(const Vertex& vertex) noexcept { return vertex.z; }
+
+    [[nodiscard]] static Vertex lerp(const Vertex& a, const Vertex& b, double t) noexcept {
+        return { a.x + (b.x - a.x) * t,
+                 a.y + (b.y - a.y) * t,
+                 a.r + (b.r - a.r) * t,
+                 a.g + (b.g - a.g) * t,
+                 a.b + (b.b - a.b) * t,
+                 a.z + (b.z - a.z) * t };
+    }
+
+    [[nodiscard]] static std::array<std::array<float, FragmentBatch::s_lanes>*, 3>
+    getLanes(FragmentBatch& batch) noexcept {
+        return { &batch.r, &batch.g, &batch.b };
+    }
+};
+
+template <>
+struct VertexTraits<PositionVertex>
+{
+    static constexpr std::size_t s_attributeCount{ 0 };
+    static constexpr bool s_hasDepth{ false };
+
+    [[nodiscard]] static std::array<double, 0> getAttributes(const PositionVertex&) noexcept {
+        return {};
+    }
+
+    [[nodiscard]] static PositionVertex
+    lerp(const PositionVertex& a, const PositionVertex& b, double t) noexcept {
+        return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t };
+    }
+
+    [[nodiscard]] static std::array<std::array<float, FragmentBatch::s_lanes>*, 0>
+    getLanes(FragmentBatch&) noexcept {
+        return {};
+    }
+};
+
+// Blend modes: how a shaded colour is combined with the pixel under it. Modes that do not read
+// the destination let the rasterizer store whole batch rows at once.
+struct BlendReplace
+{
+    static constexpr bool s_readsDestination{ false };
+
+    [[nodiscard]] static Color blend(Color source, Color) noexcept { return source; }
+};
+
+struct BlendAdd
+{
+    static constexpr bool s_readsDestination{ true };
+
+    [[nodiscard]] static Color blend(Color source, Color destination) noexcept {
+        const auto add{ [](std::uint8_t a, std::uint8_t b) {
+            return static_cast<std::uint8_t>(std::min(a + b, 255));
+        } };
+        return { add(source.red, destination.red),
+                 add(source.green, destination.green),
+                 add(source.blue, destination.blue) };
+    }
+};
+
+struct BlendAverage
+{
+    static constexpr bool s_readsDestination{ true };
+
+    [[nodiscard]] static Color blend(Color source, Color destination) noexcept {
+        const auto average{ [](std::uint8_t a, std::uint8_t b) {
+            return static_cast<std::uint8_t>((a + b) / 2);
+        } };
+        return { average(source.red, destination.red),
+                 average(source.green, destination.green),
+                 average(source.blue, destination.blue) };
+    }
+};
+
+// Depth modes. DepthOff draws in submission order, its types are never used. DepthTest compares
+// fragments with the canvas depth attachment of type Buffer, the fragments that fail are not
+// shaded.
+struct DepthOff
+{
+    static constexpr bool s_isEnabled{ false };
+    static constexpr bool s_isWriting{ false };
+    using Value = std::uint16_t;
+    using Buffer = DepthBuffer<Value>;
+};
+
+enum class DepthCompare
+{
+    less,
+    lessEqual,
+    greater,
+    greaterEqual,
+    always
+};
+
+// What a whole block of fragments does in the depth test.
+enum class DepthBlock
+{
+    fails,
+    passes,
+    mixed
+};
+
+template <typename ValueT, DepthCompare compare = DepthCompare::less, bool isWriting = true>
+struct DepthTest
+{
+    static constexpr bool s_isEnabled{ true };
+    static constexpr bool s_isWriting{ isWriting };
+    using Value = ValueT;
+    using Buffer = DepthBuffer<ValueT>;
+
+    [[nodiscard]] static bool passes(Value fragment, Value stored) noexcept {
+        if constexpr (compare == DepthCompare::less) return fragment < stored;
+        if constexpr (compare == DepthCompare::lessEqual) return fragment <= stored;
+        if constexpr (compare == DepthCompare::greater) return fragment > stored;
+        if constexpr (compare == DepthCompare::greaterEqual) return fragment >= stored;
+        return true;
+    }
+
+    // Fragments with depth in [low, high] against a block storing depths in [blockLow,
+    // blockHigh]. The block fails or passes whole if every pair compares the same way.
+    [[nodiscard]] static DepthBlock
+    testBlock(Value low, Value high, Value blockLow, Value blockHigh) noexcept {
+        if constexpr (compare == DepthCompare::always) return DepthBlock::passes;
+        if constexpr (compare == DepthCompare::less || compare == DepthCompare::lessEqual) {
+            if (!passes(low, blockHigh)) return DepthBlock::fails;
+            if (passes(high, blockLow)) return DepthBlock::passes;
+        }
+        if constexpr (compare == DepthCompare::greater || compare == DepthCompare::greaterEqual) {
+            if (!passes(high, blockLow)) return DepthBlock::fails;
+            if (passes(low, blockHigh)) return DepthBlock::passes;
+        }
+        return DepthBlock::mixed;
+    }
+};
+
+// Work done by a rasterizer. Fragments are covered samples, a rejected block is a tile skipped
+// whole by its depth range before any of its samples was tested. Culled triangles were dropped
+// before setup, clipped ones were cut into smaller triangles first.
+struct RasterStats
+{
+    std::size_t shadedFragments{};
+    std::size_t rejectedFragments{};
+    std::size_t rejectedBlocks{};
+    std::size_t culledTriangles{};
+    std::size_t clippedTriangles{};
+
+    RasterStats& operator+=(const RasterStats& stats) noexcept {
+        shadedFragments += stats.shadedFragments;
+        rejectedFragments += stats.rejectedFragments;
+        rejectedBlocks += stats.rejectedBlocks;
+        culledTriangles += stats.culledTriangles;
+        clippedTriangles += stats.clippedTriangles;
+        return *this;
+    }
+};
+
+} // namespace graphics
+
+#endif // RENDER_BASIC_PIPELINE_STATE_HXX
@@ -3,14 +3,20 @@
 //
 #include <SDL3/SDL.h>
 #include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <thread>
 
+#include "fragment_batch.hxx"
+#include "frame_exchange.hxx"
 #include "gfx_program.hxx"
+#include "tile_rasterizer.hxx"
 #include "triangle_interpolated.hxx"
 
 using namespace std::literals;
 
 namespace graphics {
-class GfxProgram : public graphics::IGfx
+class GfxProgram final : public graphics::IBatchGfx
 {
 private:
     Color m_color{};
@@ -18,6 +24,7 @@ private:
     double m_mouseX{};
     double m_mouseY{};
     double radius{ 20 };
+    std::uint32_t m_noise{ 0x9e37'79b9 };
 
 public:
     void setUniforms(const graphics::Uniform& uniform) override {
@@ -32,18 +39,32 @@ public:
         radius = uniform.p7;
     };
 
-    Color fragmentShader(const graphics::Vertex& vertex) override {
-        Color color{ vertex.extractColor() };
-
-        auto dist{ distance(vertex.extractPosition(), graphics::Position(m_mouseX, m_mouseY)) };
-        if (dist <= radius * m_scale) return color;
-
-        Color rand{ Color::generateRandom() };
-        color.red = graphics::interpolate(vertex.r, rand.red, 0.5);
-        color.green = graphics::interpolate(vertex.g, rand.green, 0.5);
-        color.blue = graphics::interpolate(vertex.b, rand.blue, 0.5);
-
-        return color;
+    // Inside the circle around the mouse the vertex colour, outside it blended half and half
+    // with noise.
+    void fragmentShader(const graphics::FragmentBatch& fragments,
+                        graphics::FragmentColors& colors) override {
+        const auto mouseX{ static_cast<float>(m_mouseX) };
+        const auto mouseY{ static_cast<float>(m_mouseY) };
+        const auto maxDist{ static_cast<float>(radius * m_scale) };
+
+        for (std::size_t lane{}; lane < graphics::FragmentBatch::s_lanes; ++lane) {
+            const auto distX{ fragments.x[lane] - mouseX };
+            const auto distY{ fragments.y[lane] - mouseY };
+            const bool isInside{ distX * distX + distY * distY <= maxDist * maxDist };
+
+            // xorshift32, one step gives the three noise channels.
+            m_noise ^= m_noise << 13;
+            m_noise ^= m_noise >> 17;
+            m_noise ^= m_noise << 5;
+            const auto noise{ isInside ? 0.0f : 0.5f };
+            const auto blend{ [&](float value, int shift) {
+                const auto random{ static_cast<float>(m_noise >> shift & 0xff) };
+                return static_cast<std::uint8_t>(value + (random - value) * noise);
+            } };
+            colors[lane] = { blend(fragments.r[lane], 0),
+                             blend(fragments.g[lane], 8),
+                             blend(fragments.b[lane], 16) };
+        }
     };
 
     Vertex vertexShader(const graphics::Vertex& vertex) override {
@@ -64,6 +85,24 @@ public:
 
 } // namespace graphics
 
+// Copies the canvas into the streaming texture, one memcpy when the row pitches match.
+static void updateTexture(SDL_Texture* texture, const graphics::Canvas& canvas) {
+    void* pixels{};
+    int pitch{};
+    if (SDL_LockTexture(texture, nullptr, &pixels, &pitch) != 0) return;
+
+    const auto rowSize{ canvas.getWidth() * sizeof(graphics::Color) };
+    const auto canvasPitch{ canvas.getPitch() * sizeof(graphics::Color) };
+    if (static_cast<std::size_t>(pitch) == canvasPitch)
+        std::memcpy(pixels, canvas.getRow(0), canvasPitch * canvas.getHeight());
+    else
+        for (std::size_t y{}; y < canvas.getHeight(); ++y)
+            std::memcpy(static_cast<std::byte*>(pixels) + y * static_cast<std::size_t>(pitch),
+                        canvas.getRow(y),
+                        rowSize);
+    SDL_UnlockTexture(texture);
+}
+
 int main() {
     constexpr int width{ 640 };
     constexpr int height{ 480 };
@@ -72,18 +111,18 @@ int main() {
     auto window{ SDL_CreateWindow("render", width, height, SDL_WINDOW_OPENGL) };
     auto renderer{ SDL_CreateRenderer(window, nullptr, SDL_RENDERER_ACCELERATED) };
 
-    graphics::Canvas canvas{ width, height };
-    graphics::GfxProgram gfx;
-    graphics::TriangleInterpolateRender render{ canvas, width, height, gfx };
+    constexpr auto format{ graphics::Color::s_format == graphics::PixelFormat::rgba8
+                               ? SDL_PIXELFORMAT_RGBA32
+                               : SDL_PIXELFORMAT_BGRA32 };
+    auto texture{
+        SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STREAMING, width, height)
+    };
 
-    std::vector<graphics::Vertex> verticesBuffer{ { 0, 0, 255, 0, 0 },
+    const std::vector<graphics::Vertex> verticesBuffer{ { 0, 0, 255, 0, 0 },
                                                   { width - 1, height - 1, 0, 255, 0 },
                                                   { 0, height - 1, 0, 0, 255 },
                                                   { width - 1, 0, 0, 0, 255 } };
-    std::vector<std::uint16_t> indicesBuffer{ 0, 1, 2, 0, 1, 3 };
-
-    void* pixels{ canvas.getPixels().data() };
-    constexpr int pitch{ sizeof(graphics::Color) * width };
+    const std::vector<std::uint16_t> indicesBuffer{ 0, 1, 2, 0, 1, 3 };
 
     graphics::Uniform uniform{};
 
@@ -101,6 +140,27 @@ int main() {
 
     bool isExit{ false };
 
+    // Frames are drawn on their own thread into a back canvas, one frame ahead of the one on
+    // screen. Uniforms go the other way: the render thread snapshots the latest ones at the start
+    // of every frame. Canvas rows are padded to 64 bytes, the texture takes them as they are.
+    graphics::FrameExchange<graphics::Canvas> frames{ graphics::Canvas{ width, height, 16 } };
+    graphics::FrameExchange<graphics::Uniform> uniforms{ uniform };
+    std::thread renderThread{ [&] {
+        graphics::GfxProgram gfx;
+        while (!frames.isClosed()) {
+            uniforms.acquire();
+            gfx.setUniforms(uniforms.getFront());
+
+            auto& canvas{ frames.getBack() };
+            canvas.clear();
+            graphics::Rasterizer render{ canvas, gfx };
+            render.drawTriangles(verticesBuffer, indicesBuffer);
+
+            frames.publish();
+            frames.waitTaken();
+        }
+    } };
+
     while (!isExit) {
         SDL_Event event{};
         while (SDL_PollEvent(&event)) {
@@ -137,8 +197,6 @@ int main() {
             }
         }
 
-        canvas.clear();
-
         if (scale < 0.05)
             scale = 0.05;
         else if (scale > 1)
@@ -152,22 +210,19 @@ int main() {
 
         if (radius >= height / 2) radius = height / 2;
 
-        gfx.setUniforms(uniform);
-
-        render.drawTriangles(verticesBuffer, indicesBuffer);
+        uniforms.getBack() = uniform;
+        uniforms.publish();
 
-        auto bitmapSurface =
-            SDL_CreateSurfaceFrom(pixels, width, height, pitch, SDL_PIXELFORMAT_RGB24);
-
-        auto texture = SDL_CreateTextureFromSurface(renderer, bitmapSurface);
-
-        SDL_DestroySurface(bitmapSurface);
+        if (frames.acquire()) updateTexture(texture, frames.getFront());
         SDL_RenderClear(renderer);
         SDL_RenderTexture(renderer, texture, nullptr, nullptr);
         SDL_RenderPresent(renderer);
-        SDL_DestroyTexture(texture);
     }
 
+    frames.close();
+    renderThread.join();
+
+    SDL_DestroyTexture(texture);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
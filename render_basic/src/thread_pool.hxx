@@ -0,0 +1,186 @@
+#ifndef RENDER_BASIC_THREAD_POOL_HXX
+#define RENDER_BASIC_THREAD_POOL_HXX
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace graphics {
+
+using namespace std::literals;
+
+// Fixed set of threads running parallel loops. Every thread starts with an even share of the
+// task indices; a thread that runs out takes the upper half of another thread's share. A share
+// is one atomic [begin, end) pair, so taking work is a compare-exchange, never a lock.
+class ThreadPool
+{
+private:
+    struct alignas(64) Share
+    {
+        std::atomic<std::uint64_t> range{};
+    };
+
+    using Invoke = void (*)(const void* function, std::size_t task, std::size_t thread);
+
+    std::vector<std::thread> m_threads{};
+    std::unique_ptr<Share[]> m_shares{};
+    std::size_t m_threadCount{};
+
+    std::mutex m_mutex{};
+    std::condition_variable m_wake{};
+    std::condition_variable m_done{};
+    std::uint64_t m_generation{};
+    std::size_t m_running{};
+    bool m_isStopping{};
+    std::exception_ptr m_exception{};
+
+    const void* m_function{};
+    Invoke m_invoke{};
+
+public:
+    // threadCount includes the thread calling parallelFor.
+    explicit ThreadPool(std::size_t threadCount)
+        : m_shares{ std::make_unique<Share[]>(threadCount) }, m_threadCount{ threadCount } {
+        if (threadCount == 0) throw std::runtime_error{ "Error : ThreadPool : no threads"s };
+
+        m_threads.reserve(threadCount - 1);
+        for (std::size_t thread{ 1 }; thread < threadCount; ++thread)
+            m_threads.emplace_back([this, thread] { workerLoop(thread); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock{ m_mutex };
+            m_isStopping = true;
+        }
+        m_wake.notify_all();
+        for (auto& thread : m_threads)
+            thread.join();
+    }
+
+    [[nodiscard]] std::size_t getThreadCount() const noexcept { return m_threadCount; }
+
+    // Calls function(task, thread) for every task in [0, count) and returns when all are done.
+    // thread is in [0, getThreadCount()), a task runs on one thread only. The first exception
+    // thrown by a task is rethrown here after the other tasks finish.
+    template <typename Function>
+    void parallelFor(std::size_t count, const Function& function) {
+        if (count > std::numeric_limits<std::uint32_t>::max())
+            throw std::runtime_error{ "Error : parallelFor : too many tasks"s };
+        if (count == 0) return;
+
+        m_function = &function;
+        m_invoke = [](const void* function, std::size_t task, std::size_t thread) {
+            (*static_cast<const Function*>(function))(task, thread);
+        };
+
+        for (std::size_t thread{}; thread < m_threadCount; ++thread)
+            m_shares[thread].range.store(pack(count * thread / m_threadCount,
+                                              count * (thread + 1) / m_threadCount),
+                                         std::memory_order_relaxed);
+        {
+            std::lock_guard lock{ m_mutex };
+            m_running = m_threadCount - 1;
+            m_exception = nullptr;
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        runTasks(0);
+
+        std::unique_lock lock{ m_mutex };
+        m_done.wait(lock, [this] { return m_running == 0; });
+        if (m_exception) std::rethrow_exception(std::exchange(m_exception, nullptr));
+    }
+
+private:
+    [[nodiscard]] static std::uint64_t pack(std::uint64_t begin, std::uint64_t end) noexcept {
+        return begin | end << 32;
+    }
+
+    [[nodiscard]] static std::uint64_t getBegin(std::uint64_t range) noexcept {
+        return range & 0xffff'ffff;
+    }
+
+    [[nodiscard]] static std::uint64_t getEnd(std::uint64_t range) noexcept { return range >> 32; }
+
+    void workerLoop(std::size_t thread) {
+        std::uint64_t generation{};
+        for (;;) {
+            {
+                std::unique_lock lock{ m_mutex };
+                m_wake.wait(lock, [&] { return m_isStopping || m_generation != generation; });
+                if (m_isStopping) return;
+                generation = m_generation;
+            }
+
+            runTasks(thread);
+
+            std::lock_guard lock{ m_mutex };
+            if (--m_running == 0) m_done.notify_one();
+        }
+    }
+
+    void runTasks(std::size_t thread) {
+        for (;;) {
+            std::uint64_t task{};
+            if (!popOwn(thread, task) && !steal(thread, task)) return;
+
+            try {
+                m_invoke(m_function, static_cast<std::size_t>(task), thread);
+            }
+            catch (...) {
+                std::lock_guard lock{ m_mutex };
+                if (!m_exception) m_exception = std::current_exception();
+            }
+        }
+    }
+
+    bool popOwn(std::size_t thread, std::uint64_t& task) {
+        auto& range{ m_shares[thread].range };
+        auto current{ range.load(std::memory_order_acquire) };
+        while (getBegin(current) < getEnd(current))
+            if (range.compare_exchange_weak(current,
+                                            pack(getBegin(current) + 1, getEnd(current)),
+                                            std::memory_order_acq_rel)) {
+                task = getBegin(current);
+                return true;
+            }
+        return false;
+    }
+
+    // Takes the upper half of the first non-empty share after this thread's own, runs its first
+    // task now and keeps the rest as the new own share.
+    bool steal(std::size_t thread, std::uint64_t& task) {
+        for (std::size_t offset{ 1 }; offset < m_threadCount; ++offset) {
+            auto& range{ m_shares[(thread + offset) % m_threadCount].range };
+            auto current{ range.load(std::memory_order_acquire) };
+            while (getBegin(current) < getEnd(current)) {
+                const auto begin{ getBegin(current) };
+                const auto end{ getEnd(current) };
+                const auto middle{ begin + (end - begin) / 2 };
+                if (range.compare_exchange_weak(
+                        current, pack(begin, middle), std::memory_order_acq_rel)) {
+                    m_shares[thread].range.store(pack(middle + 1, end), std::memory_order_release);
+                    task = middle;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace graphics
+
+#endif // RENDER_BASIC_THREAD_POOL_HXX
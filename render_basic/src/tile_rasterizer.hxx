@@ -0,0 +1,473 @@
+#ifndef RENDER_BASIC_TILE_RASTERIZER_HXX
+#define RENDER_BASIC_TILE_RASTERIZER_HXX
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "canvas.hxx"
+#include "clipper.hxx"
+#include "depth_buffer.hxx"
+#include "fragment_batch.hxx"
+#include "gfx_program.hxx"
+#include "pipeline_state.hxx"
+#include "triangle_interpolated.hxx"
+
+namespace graphics {
+
+// A triangle prepared for rasterization.
+//
+// Fill rule: a pixel is sampled at its integer coordinates, the pixel indices vertices are given
+// in everywhere in render_basic, vertex positions are snapped to 1/256 of a pixel. A sample
+// inside the triangle is covered. A sample exactly on an edge is covered only if it is a top
+// edge (horizontal, the triangle below it) or a left edge. Triangles sharing an edge cover every
+// sample on it exactly once, and coverage does not depend on the winding or the tile order.
+template <typename VertexT>
+struct TriangleSetup
+{
+    static constexpr std::size_t s_attributeCount{ VertexTraits<VertexT>::s_attributeCount };
+
+    static constexpr int s_subpixelBits{ 8 };
+    static constexpr std::int64_t s_subpixelOne{ std::int64_t{ 1 } << s_subpixelBits };
+
+    // Edge function of a->b times the doubled triangle area, positive inside. Stepped by whole
+    // pixels, every value is exact.
+    struct Edge
+    {
+        std::int64_t stepX{};
+        std::int64_t stepY{};
+        std::int64_t origin{};   // value at pixel (0, 0)
+        std::int64_t minValue{}; // 0 for top left edges, 1 for the others
+
+        [[nodiscard]] std::int64_t at(std::int64_t x, std::int64_t y) const noexcept {
+            return origin + stepX * x + stepY * y;
+        }
+    };
+
+    // A vertex attribute as a linear function of the sample, relative to (minX, minY).
+    struct Plane
+    {
+        double atMin{};
+        double stepX{};
+        double stepY{};
+
+        [[nodiscard]] double at(std::int64_t dx, std::int64_t dy) const noexcept {
+            return atMin + stepX * static_cast<double>(dx) + stepY * static_cast<double>(dy);
+        }
+    };
+
+    // Edge k is opposite to vertex k, so its value is the barycentric weight of that vertex. The
+    // bounds are the samples the triangle can cover, clamped to the canvas.
+    std::array<Edge, 3> edges{};
+    std::array<Plane, s_attributeCount> attributes{};
+    Plane depth{}; // zero for vertex types without depth
+
+    std::int64_t minX{};
+    std::int64_t minY{};
+    std::int64_t maxX{};
+    std::int64_t maxY{};
+
+    // Nothing when the triangle is degenerate or covers no sample of the canvas.
+    [[nodiscard]] static std::optional<TriangleSetup> create(const VertexT& v0,
+                                                             const VertexT& v1,
+                                                             const VertexT& v2,
+                                                             std::size_t width,
+                                                             std::size_t height) {
+        if (width == 0 || height == 0) return std::nullopt;
+
+        std::array<const VertexT*, 3> ordered{ &v0, &v1, &v2 };
+        std::array<std::int64_t, 3> x{ snap(v0.x), snap(v1.x), snap(v2.x) };
+        std::array<std::int64_t, 3> y{ snap(v0.y), snap(v1.y), snap(v2.y) };
+
+        auto area{ (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]) };
+        if (area == 0) return std::nullopt;
+        if (area < 0) {
+            std::swap(ordered[1], ordered[2]);
+            std::swap(x[1], x[2]);
+            std::swap(y[1], y[2]);
+            area = -area;
+        }
+
+        // Samples are at whole pixels: the first one at or after the minimum, the last one at or
+        // before the maximum.
+        TriangleSetup setup{ .edges = { makeEdge(x[1], y[1], x[2], y[2]),
+                                        makeEdge(x[2], y[2], x[0], y[0]),
+                                        makeEdge(x[0], y[0], x[1], y[1]) },
+                             .minX = std::max(ceilToPixel(std::ranges::min(x)), std::int64_t{}),
+                             .minY = std::max(ceilToPixel(std::ranges::min(y)), std::int64_t{}),
+                             .maxX = std::min(floorToPixel(std::ranges::max(x)),
+                                              static_cast<std::int64_t>(width) - 1),
+                             .maxY = std::min(floorToPixel(std::ranges::max(y)),
+                                              static_cast<std::int64_t>(height) - 1) };
+        if (setup.minX > setup.maxX || setup.minY > setup.maxY) return std::nullopt;
+
+        const double invArea{ 1.0 / static_cast<double>(area) };
+        for (std::size_t k{}; k < 3; ++k) {
+            const auto& edge{ setup.edges[k] };
+            const auto values{ VertexTraits<VertexT>::getAttributes(*ordered[k]) };
+            for (std::size_t attribute{}; attribute < s_attributeCount; ++attribute)
+                addToPlane(setup.attributes[attribute], edge, values[attribute] * invArea, setup);
+            if constexpr (VertexTraits<VertexT>::s_hasDepth)
+                addToPlane(setup.depth,
+                           edge,
+                           VertexTraits<VertexT>::getDepth(*ordered[k]) * invArea,
+                           setup);
+        }
+        return setup;
+    }
+
+private:
+    static void
+    addToPlane(Plane& plane, const Edge& edge, double weight, const TriangleSetup& setup) noexcept {
+        plane.atMin += weight * static_cast<double>(edge.at(setup.minX, setup.minY));
+        plane.stepX += weight * static_cast<double>(edge.stepX);
+        plane.stepY += weight * static_cast<double>(edge.stepY);
+    }
+
+    [[nodiscard]] static std::int64_t snap(double coordinate) noexcept {
+        return std::llround(coordinate * static_cast<double>(s_subpixelOne));
+    }
+
+    [[nodiscard]] static std::int64_t floorToPixel(std::int64_t value) noexcept {
+        return value >> s_subpixelBits;
+    }
+
+    [[nodiscard]] static std::int64_t ceilToPixel(std::int64_t value) noexcept {
+        return -((-value) >> s_subpixelBits);
+    }
+
+    [[nodiscard]] static Edge
+    makeEdge(std::int64_t ax, std::int64_t ay, std::int64_t bx, std::int64_t by) noexcept {
+        const auto dx{ bx - ax };
+        const auto dy{ by - ay };
+        // With y pointing down and a positive area, left edges go up and top edges go right.
+        const bool isTopLeft{ dy < 0 || (dy == 0 && dx > 0) };
+        return { .stepX = -dy * s_subpixelOne,
+                 .stepY = dx * s_subpixelOne,
+                 .origin = dy * ax - dx * ay,
+                 .minValue = isTopLeft ? 0 : 1 };
+    }
+};
+
+// Half-space rasterizer over 8x8 tiles, writes straight into the canvas. Every tile row is shaded
+// as one FragmentBatch.
+//
+// The pipeline is fixed at compile time: VertexT is the vertex type and its interpolated
+// attributes, ShaderT gives vertexShader(VertexT) and fragmentShader(FragmentBatch,
+// FragmentColors), BlendT and DepthT are the modes of pipeline_state.hxx. A final shader class is
+// called directly and inlined into the tile loop, IBatchGfx is called virtually once per batch.
+// Indices are checked once per draw, the tile loop indexes the canvas without checks.
+//
+// With a depth test, every tile is first tested as a whole against the depth range of its block
+// and skipped if it fails, then fragments are tested one by one before shading (early z).
+//
+// Triangles go through TriangleClipper before setup: off-screen ones are culled, the ones
+// reaching past the guard band are clipped to it and, with a depth test, to the depth range.
+template <typename VertexT,
+          typename ShaderT,
+          typename BlendT = BlendReplace,
+          typename DepthT = DepthOff>
+    requires requires(ShaderT& shader, const FragmentBatch& batch, FragmentColors& colors) {
+        { shader.vertexShader(VertexT{}) } -> std::convertible_to<VertexT>;
+        shader.fragmentShader(batch, colors);
+    }
+class Rasterizer
+{
+public:
+    static constexpr std::size_t s_tileSize{ FragmentBatch::s_lanes };
+
+    using Setup = TriangleSetup<VertexT>;
+
+private:
+    Canvas& m_canvas;
+    ShaderT& m_shader;
+    TriangleClipper<VertexT> m_clipper;
+    typename DepthT::Buffer* m_depth{};
+    RasterStats m_stats{};
+
+public:
+    Rasterizer(Canvas& canvas, ShaderT& shader)
+        : m_canvas{ canvas }, m_shader{ shader },
+          m_clipper{ canvas.getWidth(), canvas.getHeight(), DepthT::s_isEnabled } {
+        if constexpr (DepthT::s_isEnabled) {
+            static_assert(VertexTraits<VertexT>::s_hasDepth, "depth test without vertex depth");
+            static_assert(s_tileSize == DepthT::Buffer::s_blockSize);
+
+            m_depth = canvas.getDepth<typename DepthT::Value>();
+            if (!m_depth)
+                throw std::runtime_error{ "Error : Rasterizer : no depth of this format"s };
+        }
+    }
+
+    // Counted over all draws since the last reset.
+    [[nodiscard]] const RasterStats& getStats() const noexcept { return m_stats; }
+    void resetStats() noexcept { m_stats = {}; }
+
+    void drawTriangles(const std::vector<VertexT>& vertices,
+                       const std::vector<std::uint16_t>& indices) {
+        if (indices.size() % 3 != 0)
+            throw std::runtime_error{ "Error : drawTriangles : indices.size() % 3 != 0"s };
+        if (std::ranges::any_of(indices, [&](std::uint16_t index) {
+                return index >= vertices.size();
+            }))
+            throw std::runtime_error{ "Error : drawTriangles : index out of range"s };
+
+        for (std::size_t i{}; i < indices.size() / 3; ++i) {
+            const VertexT v0{ m_shader.vertexShader(vertices[indices[i * 3 + 0]]) };
+            const VertexT v1{ m_shader.vertexShader(vertices[indices[i * 3 + 1]]) };
+            const VertexT v2{ m_shader.vertexShader(vertices[indices[i * 3 + 2]]) };
+
+            rasterizeTriangle(v0, v1, v2);
+        }
+    }
+
+    void rasterizeTriangle(const VertexT& v0, const VertexT& v1, const VertexT& v2) {
+        const auto result{ m_clipper.clip(
+            v0, v1, v2, [this](const VertexT& a, const VertexT& b, const VertexT& c) {
+                const auto setup{
+                    Setup::create(a, b, c, m_canvas.getWidth(), m_canvas.getHeight())
+                };
+                if (setup)
+                    rasterizeRegion(*setup, setup->minX, setup->minY, setup->maxX, setup->maxY);
+            }) };
+        countClipResult(result, m_stats);
+    }
+
+    void rasterizeRegion(const Setup& setup,
+                         std::int64_t left,
+                         std::int64_t top,
+                         std::int64_t right,
+                         std::int64_t bottom) {
+        rasterizeRegion(setup, left, top, right, bottom, m_stats);
+    }
+
+    // Shades the samples of the triangle inside the region, in pixels, inclusive, and counts the
+    // work into stats. Regions that do not overlap in tiles may be rasterized from different
+    // threads, each with its own stats, if the shader allows it.
+    void rasterizeRegion(const Setup& setup,
+                         std::int64_t left,
+                         std::int64_t top,
+                         std::int64_t right,
+                         std::int64_t bottom,
+                         RasterStats& stats) {
+        const auto minX{ std::max(left, setup.minX) };
+        const auto minY{ std::max(top, setup.minY) };
+        const auto maxX{ std::min(right, setup.maxX) };
+        const auto maxY{ std::min(bottom, setup.maxY) };
+
+        constexpr auto tileSize{ static_cast<std::int64_t>(s_tileSize) };
+        for (auto tileY{ minY / tileSize * tileSize }; tileY <= maxY; tileY += tileSize) {
+            const auto tileTop{ std::max(tileY, minY) };
+            const auto tileBottom{ std::min(tileY + tileSize - 1, maxY) };
+
+            for (auto tileX{ minX / tileSize * tileSize }; tileX <= maxX; tileX += tileSize) {
+                const auto tileLeft{ std::max(tileX, minX) };
+                const auto tileRight{ std::min(tileX + tileSize - 1, maxX) };
+
+                // Edge functions are linear, their extremes over the block are at its corners.
+                bool isOutside{};
+                bool isInside{ true };
+                for (const auto& edge : setup.edges) {
+                    const auto [low, high]{ std::minmax({ edge.at(tileLeft, tileTop),
+                                                          edge.at(tileRight, tileTop),
+                                                          edge.at(tileLeft, tileBottom),
+                                                          edge.at(tileRight, tileBottom) }) };
+                    isOutside |= high < edge.minValue;
+                    isInside &= low >= edge.minValue;
+                }
+
+                if (isOutside) continue;
+
+                if constexpr (DepthT::s_isEnabled) {
+                    const auto depthBlock{
+                        testDepthBlock(setup, tileLeft, tileRight, tileTop, tileBottom)
+                    };
+                    if (depthBlock == DepthBlock::fails) {
+                        ++stats.rejectedBlocks;
+                        continue;
+                    }
+                    if (depthBlock == DepthBlock::mixed) {
+                        if (isInside)
+                            shadeBlock<false, true>(
+                                setup, tileLeft, tileRight, tileTop, tileBottom, stats);
+                        else
+                            shadeBlock<true, true>(
+                                setup, tileLeft, tileRight, tileTop, tileBottom, stats);
+                        continue;
+                    }
+                }
+
+                if (isInside)
+                    shadeBlock<false, false>(
+                        setup, tileLeft, tileRight, tileTop, tileBottom, stats);
+                else
+                    shadeBlock<true, false>(
+                        setup, tileLeft, tileRight, tileTop, tileBottom, stats);
+            }
+        }
+    }
+
+private:
+    static void countClipResult(typename TriangleClipper<VertexT>::Result result,
+                                RasterStats& stats) noexcept {
+        using Result = typename TriangleClipper<VertexT>::Result;
+        stats.culledTriangles += result == Result::culled;
+        stats.clippedTriangles += result == Result::clipped;
+    }
+
+    // The depth range of the triangle over the tile against the one stored in its block. The
+    // plane is linear, its extremes are at the corners; one step of slack on each side covers
+    // the rounding of the per-fragment values.
+    [[nodiscard]] DepthBlock testDepthBlock(const Setup& setup,
+                                            std::int64_t left,
+                                            std::int64_t right,
+                                            std::int64_t top,
+                                            std::int64_t bottom) const noexcept {
+        using Buffer = typename DepthT::Buffer;
+
+        const auto [low, high]{ std::minmax({ setup.depth.at(left - setup.minX, top - setup.minY),
+                                              setup.depth.at(right - setup.minX, top - setup.minY),
+                                              setup.depth.at(left - setup.minX,
+                                                             bottom - setup.minY),
+                                              setup.depth.at(right - setup.minX,
+                                                             bottom - setup.minY) }) };
+        auto quantizedLow{ Buffer::quantize(low) };
+        auto quantizedHigh{ Buffer::quantize(high) };
+        if (quantizedLow > 0) --quantizedLow;
+        if (quantizedHigh < Buffer::s_far) ++quantizedHigh;
+
+        const auto blockX{ static_cast<std::size_t>(left) / s_tileSize };
+        const auto blockY{ static_cast<std::size_t>(top) / s_tileSize };
+        return DepthT::testBlock(quantizedLow,
+                                 quantizedHigh,
+                                 m_depth->getBlockMin(blockX, blockY),
+                                 m_depth->getBlockMax(blockX, blockY));
+    }
+
+    // isDepthTested: the block range did not decide the depth test, every fragment is tested.
+    template <bool isPartial, bool isDepthTested>
+    void shadeBlock(const Setup& setup,
+                    std::int64_t left,
+                    std::int64_t right,
+                    std::int64_t top,
+                    std::int64_t bottom,
+                    RasterStats& stats) {
+        const auto count{ static_cast<std::size_t>(right - left + 1) };
+        const std::uint32_t rowMask{ (1u << count) - 1 };
+
+        FragmentBatch batch{};
+        FragmentColors colors{};
+        interpolateLanes(batch.x, static_cast<float>(left), 1.0f);
+        const auto lanes{ VertexTraits<VertexT>::getLanes(batch) };
+        [[maybe_unused]] bool isDepthWritten{};
+
+        for (auto y{ top }; y <= bottom; ++y) {
+            auto mask{ rowMask };
+            if constexpr (isPartial)
+                for (const auto& edge : setup.edges)
+                    mask &= coverLanes(edge.at(left, y), edge.stepX, edge.minValue);
+            if (mask == 0) continue;
+
+            [[maybe_unused]] std::array<typename DepthT::Value, s_tileSize> depths{};
+            [[maybe_unused]] typename DepthT::Value* depthRow{};
+            if constexpr (DepthT::s_isEnabled) {
+                depthRow = m_depth->getRow(static_cast<std::size_t>(y)) + left;
+                const double start{ setup.depth.at(left - setup.minX, y - setup.minY) };
+                const auto covered{ mask };
+                for (std::size_t lane{}; lane < count; ++lane) {
+                    depths[lane] = DepthT::Buffer::quantize(
+                        start + setup.depth.stepX * static_cast<double>(lane));
+                    if constexpr (isDepthTested)
+                        if (!DepthT::passes(depths[lane], depthRow[lane])) mask &= ~(1u << lane);
+                }
+                stats.rejectedFragments +=
+                    static_cast<std::size_t>(std::popcount(covered) - std::popcount(mask));
+                if (mask == 0) continue;
+            }
+
+            batch.mask = mask;
+            batch.y.fill(static_cast<float>(y));
+            for (std::size_t attribute{}; attribute < Setup::s_attributeCount; ++attribute) {
+                const auto& plane{ setup.attributes[attribute] };
+                interpolateLanes(*lanes[attribute],
+                                 static_cast<float>(plane.at(left - setup.minX, y - setup.minY)),
+                                 static_cast<float>(plane.stepX));
+            }
+
+            m_shader.fragmentShader(batch, colors);
+            stats.shadedFragments += batch.count();
+
+            if constexpr (DepthT::s_isEnabled && DepthT::s_isWriting) {
+                for (std::size_t lane{}; lane < count; ++lane)
+                    if (batch.isCovered(lane)) depthRow[lane] = depths[lane];
+                isDepthWritten = true;
+            }
+
+            Color* row{ m_canvas.getRow(static_cast<std::size_t>(y)) + left };
+            if constexpr (!BlendT::s_readsDestination)
+                if (mask == rowMask) {
+                    std::copy_n(colors.begin(), count, row);
+                    continue;
+                }
+            for (std::size_t lane{}; lane < count; ++lane)
+                if (batch.isCovered(lane)) row[lane] = BlendT::blend(colors[lane], row[lane]);
+        }
+
+        if constexpr (DepthT::s_isEnabled && DepthT::s_isWriting)
+            if (isDepthWritten)
+                m_depth->updateBlock(static_cast<std::size_t>(left) / s_tileSize,
+                                     static_cast<std::size_t>(top) / s_tileSize);
+    }
+};
+
+template <typename ShaderT>
+Rasterizer(Canvas&, ShaderT&) -> Rasterizer<Vertex, ShaderT>;
+
+// Rasterizer for a per-fragment IGfx, through GfxBatchAdapter.
+class TileRasterizer
+{
+public:
+    using Pipeline = Rasterizer<Vertex, GfxBatchAdapter>;
+    static constexpr std::size_t s_tileSize{ Pipeline::s_tileSize };
+
+private:
+    GfxBatchAdapter m_adapter;
+    Pipeline m_rasterizer;
+
+public:
+    TileRasterizer(Canvas& canvas, IGfx& gfx)
+        : m_adapter{ gfx }, m_rasterizer{ canvas, m_adapter } {}
+
+    TileRasterizer(const TileRasterizer&) = delete;
+    TileRasterizer& operator=(const TileRasterizer&) = delete;
+
+    void drawTriangles(const std::vector<Vertex>& vertices,
+                       const std::vector<std::uint16_t>& indices) {
+        m_rasterizer.drawTriangles(vertices, indices);
+    }
+
+    void rasterizeTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2) {
+        m_rasterizer.rasterizeTriangle(v0, v1, v2);
+    }
+
+    void rasterizeRegion(const Pipeline::Setup& setup,
+                         std::int64_t left,
+                         std::int64_t top,
+                         std::int64_t right,
+                         std::int64_t bottom,
+                         RasterStats& stats) {
+        m_rasterizer.rasterizeRegion(setup, left, top, right, bottom, stats);
+    }
+
+    [[nodiscard]] const RasterStats& getStats() const noexcept { return m_rasterizer.getStats(); }
+    void resetStats() noexcept { m_rasterizer.resetStats(); }
+};
+
+} // namespace graphics
+
+#endif // RENDER_BASIC_TILE_RASTERIZER_HXX
@@ -4,55 +4,58 @@
 
 #ifndef RENDER_BASIC_TRIANGLE_INTERPOLATED_HXX
 #define RENDER_BASIC_TRIANGLE_INTERPOLATED_HXX
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
 #include <functional>
 #include <stdexcept>
+#include <utility>
 
+#include "clipper.hxx"
 #include "gfx_program.hxx"
 #include "triangle_indexed_render.hxx"
+#include "vertex.hxx"
 
 namespace graphics {
 
-struct Vertex
+// How TriangleInterpolateRender walks a triangle. floatingPoint interpolates every fragment in
+// doubles along scanlines. fixedPoint snaps the vertices to 28.4 fixed point, covers the samples
+// at whole pixels with integer edge functions and the top left fill rule of TriangleSetup, and
+// steps the colours and the depth as 16.16 integers: coverage is exact and the same on every
+// platform, shared edges are drawn once.
+enum class RasterMode
 {
-    double x{};
-    double y{};
-
-    double r{};
-    double g{};
-    double b{};
-
-    [[nodiscard]] Position extractPosition() const {
-        return { static_cast<std::size_t>(x), static_cast<std::size_t>(y) };
-    }
-
-    [[nodiscard]] Color extractColor() const {
-        return { static_cast<std::uint8_t>(r),
-                 static_cast<std::uint8_t>(g),
-                 static_cast<std::uint8_t>(b) };
-    }
+    floatingPoint,
+    fixedPoint
 };
 
-static double interpolate(const double start, const double end, const double t) {
-    if (t < 0 || t > 1) throw std::runtime_error{ "Error : interpolate : t < 0 || t > 1"s };
-    return start + (end - start) * t;
-}
-
-static Vertex interpolate(const Vertex& start, const Vertex& end, const double t) {
-    return { interpolate(start.x, end.x, t),
-             interpolate(start.y, end.y, t),
-             interpolate(start.r, end.r, t),
-             interpolate(start.g, end.g, t),
-             interpolate(start.b, end.b, t) };
-}
-
 class TriangleInterpolateRender : public TriangleIndexedRender
 {
 private:
+    // 28.4 positions, the clipper keeps them within the guard band.
+    static constexpr int s_subpixelBits{ 4 };
+    static constexpr std::int64_t s_subpixelOne{ std::int64_t{ 1 } << s_subpixelBits };
+
+    // 16.16 attributes: r, g, b and z.
+    static constexpr int s_attributeBits{ 16 };
+    static constexpr double s_attributeOne{ 1 << s_attributeBits };
+    static constexpr std::size_t s_attributeCount{ 4 };
+
+    using Attributes = std::array<std::int64_t, s_attributeCount>;
+
     IGfx& m_gfx;
+    RasterMode m_mode{};
+    TriangleClipper<Vertex> m_clipper;
 
 public:
-    TriangleInterpolateRender(Canvas& canvas, std::size_t width, std::size_t height, IGfx& gfx)
-        : TriangleIndexedRender(canvas, width, height), m_gfx{ gfx } {}
+    TriangleInterpolateRender(Canvas& canvas,
+                              std::size_t width,
+                              std::size_t height,
+                              IGfx& gfx,
+                              RasterMode mode = RasterMode::floatingPoint)
+        : TriangleIndexedRender(canvas, width, height), m_gfx{ gfx }, m_mode{ mode },
+          m_clipper{ canvas.getWidth(), canvas.getHeight(), false } {}
 
     void drawTriangles(const std::vector<Vertex>& vertices,
                        const std::vector<std::uint16_t>& indices) {
@@ -72,58 +75,220 @@ public:
             v1 = m_gfx.vertexShader(v1);
             v2 = m_gfx.vertexShader(v2);
 
-            auto interpolatedTriangle{ rasterizeTriangle(v0, v1, v2) };
+            // Off-screen and non-finite triangles are culled, the ones past the guard band are
+            // clipped to it.
+            m_clipper.clip(v0, v1, v2, [this](const Vertex& a, const Vertex& b, const Vertex& c) {
+                if (m_mode == RasterMode::fixedPoint) {
+                    rasterizeFixedPoint(a, b, c);
+                    return;
+                }
 
-            std::ranges::for_each(interpolatedTriangle, [&](const Vertex& vertex) {
-                m_canvas.setPixel(vertex.extractPosition(), m_gfx.fragmentShader(vertex));
+                rasterizeTriangle(a, b, c);
             });
         }
     }
 
 private:
-    [[nodiscard]] static std::vector<Vertex> rasterizeOneHorizontalLine(const Vertex& left,
-                                                                        const Vertex& right) {
-        std::vector<Vertex> result{};
+
+    [[nodiscard]] bool isOnCanvas(const Vertex& vertex) const {
+        return vertex.x >= 0 && vertex.y >= 0 &&
+               vertex.x < static_cast<double>(m_canvas.getWidth()) &&
+               vertex.y < static_cast<double>(m_canvas.getHeight());
+    }
+
+    // Edge function of a->b times the doubled area, positive inside, in 28.4 squared units.
+    struct FixedEdge
+    {
+        std::int64_t stepX{};
+        std::int64_t stepY{};
+        std::int64_t value{};    // at the first sample of the current row
+        std::int64_t minValue{}; // 0 for top left edges, 1 for the others
+    };
+
+    void rasterizeFixedPoint(const Vertex& v0, const Vertex& v1, const Vertex& v2) {
+        std::array<const Vertex*, 3> ordered{ &v0, &v1, &v2 };
+        std::array<std::int64_t, 3> x{ snap(v0.x), snap(v1.x), snap(v2.x) };
+        std::array<std::int64_t, 3> y{ snap(v0.y), snap(v1.y), snap(v2.y) };
+        auto area{ (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]) };
+        if (area == 0) return;
+        if (area < 0) {
+            std::swap(ordered[1], ordered[2]);
+            std::swap(x[1], x[2]);
+            std::swap(y[1], y[2]);
+            area = -area;
+        }
+
+        const auto minX{ std::max(-(-std::ranges::min(x) >> s_subpixelBits), std::int64_t{}) };
+        const auto minY{ std::max(-(-std::ranges::min(y) >> s_subpixelBits), std::int64_t{}) };
+        const auto maxX{ std::min(std::ranges::max(x) >> s_subpixelBits,
+                                  static_cast<std::int64_t>(m_canvas.getWidth()) - 1) };
+        const auto maxY{ std::min(std::ranges::max(y) >> s_subpixelBits,
+                                  static_cast<std::int64_t>(m_canvas.getHeight()) - 1) };
+        if (minX > maxX || minY > maxY) return;
+
+        // Edge k is opposite to vertex k, its value is the weight of that vertex.
+        std::array<FixedEdge, 3> edges{};
+        for (std::size_t k{}; k < 3; ++k) {
+            const auto a{ (k + 1) % 3 };
+            const auto b{ (k + 2) % 3 };
+            const auto dx{ x[b] - x[a] };
+            const auto dy{ y[b] - y[a] };
+            const bool isTopLeft{ dy < 0 || (dy == 0 && dx > 0) };
+            edges[k] = { .stepX = -dy * s_subpixelOne,
+                         .stepY = dx * s_subpixelOne,
+                         .value = dy * (x[a] - minX * s_subpixelOne) -
+                                  dx * (y[a] - minY * s_subpixelOne),
+                         .minValue = isTopLeft ? 0 : 1 };
+        }
+
+        // Attribute planes are set up once in doubles, then stepped in integers. Values are
+        // clamped to the range of the vertices, which the rounding of the steps may leave.
+        Attributes row{};
+        Attributes stepX{};
+        Attributes stepY{};
+        Attributes low{};
+        Attributes high{};
+        for (std::size_t attribute{}; attribute < s_attributeCount; ++attribute) {
+            double atMin{};
+            double planeX{};
+            double planeY{};
+            for (std::size_t k{}; k < 3; ++k) {
+                const double weight{ getAttribute(*ordered[k], attribute) /
+                                     static_cast<double>(area) };
+                atMin += weight * static_cast<double>(edges[k].value);
+                planeX += weight * static_cast<double>(edges[k].stepX);
+                planeY += weight * static_cast<double>(edges[k].stepY);
+            }
+            row[attribute] = toFixed(atMin);
+            stepX[attribute] = toFixed(planeX);
+            stepY[attribute] = toFixed(planeY);
+
+            const auto [lowValue, highValue]{ std::minmax({ getAttribute(v0, attribute),
+                                                            getAttribute(v1, attribute),
+                                                            getAttribute(v2, attribute) }) };
+            low[attribute] = toFixed(lowValue);
+            high[attribute] = toFixed(highValue);
+        }
+
+        for (auto sampleY{ minY }; sampleY <= maxY; ++sampleY) {
+            auto e0{ edges[0].value };
+            auto e1{ edges[1].value };
+            auto e2{ edges[2].value };
+            auto values{ row };
+            for (auto sampleX{ minX }; sampleX <= maxX; ++sampleX) {
+                if (e0 >= edges[0].minValue && e1 >= edges[1].minValue &&
+                    e2 >= edges[2].minValue) {
+                    const Vertex fragment{ static_cast<double>(sampleX),
+                                           static_cast<double>(sampleY),
+                                           fromFixed(values[0], low[0], high[0]),
+                                           fromFixed(values[1], low[1], high[1]),
+                                           fromFixed(values[2], low[2], high[2]),
+                                           fromFixed(values[3], low[3], high[3]) };
+                    m_canvas.setPixel(fragment.extractPosition(), m_gfx.fragmentShader(fragment));
+                }
+                e0 += edges[0].stepX;
+                e1 += edges[1].stepX;
+                e2 += edges[2].stepX;
+                for (std::size_t attribute{}; attribute < s_attributeCount; ++attribute)
+                    values[attribute] += stepX[attribute];
+            }
+            for (auto& edge : edges)
+                edge.value += edge.stepY;
+            for (std::size_t attribute{}; attribute < s_attributeCount; ++attribute)
+                row[attribute] += stepY[attribute];
+        }
+    }
+
+    [[nodiscard]] static std::int64_t snap(double coordinate) noexcept {
+        return std::llround(coordinate * static_cast<double>(s_subpixelOne));
+    }
+
+    [[nodiscard]] static std::int64_t toFixed(double value) noexcept {
+        return std::llround(value * s_attributeOne);
+    }
+
+    [[nodiscard]] static double
+    fromFixed(std::int64_t value, std::int64_t low, std::int64_t high) noexcept {
+        return static_cast<double>(std::clamp(value, low, high)) / s_attributeOne;
+    }
+
+    [[nodiscard]] static double getAttribute(const Vertex& vertex, std::size_t attribute) noexcept {
+        switch (attribute) {
+        case 0:
+            return vertex.r;
+        case 1:
+            return vertex.g;
+        case 2:
+            return vertex.b;
+        default:
+            return vertex.z;
+        }
+    }
+
+    // The steps i in [0, count] of start + (end - start) * i / count that can fall in
+    // [0, limit), one more on each side so rounding never drops a fragment on the canvas.
+    [[nodiscard]] static std::pair<std::size_t, std::size_t>
+    getVisibleSteps(double start, double end, std::size_t count, double limit) noexcept {
+        if (start == end) return { 0, count };
+
+        const auto toStep{ [&](double value) {
+            return (value - start) / (end - start) * static_cast<double>(count);
+        } };
+        const double atZero{ toStep(0.0) };
+        const double atLimit{ toStep(limit) };
+        const double low{ std::min(atZero, atLimit) };
+        const double high{ std::max(atZero, atLimit) };
+        const auto size{ static_cast<double>(count) };
+        return { static_cast<std::size_t>(std::clamp(std::floor(low) - 1.0, 0.0, size)),
+                 static_cast<std::size_t>(std::clamp(std::ceil(high) + 1.0, 0.0, size)) };
+    }
+
+    // Every fragment goes through the virtual IGfx::fragmentShader, so unlike LineRender the
+    // runs can't be written with Canvas::fillSpan: each pixel is shaded and set on its own,
+    // straight from the scanline walk without collecting the fragments first.
+    void shadeFragment(const Vertex& fragment) {
+        // Only the fragments of the rows and runs that reach the canvas are interpolated, the
+        // few of them just off it are dropped.
+        if (isOnCanvas(fragment))
+            m_canvas.setPixel(fragment.extractPosition(), m_gfx.fragmentShader(fragment));
+    }
+
+    void rasterizeOneHorizontalLine(const Vertex& left, const Vertex& right) {
         std::size_t lineSize{ static_cast<std::size_t>(std::abs(right.x - left.x)) };
         if (lineSize > 0) {
             lineSize += 1;
-            for (std::size_t i{}; i <= lineSize; ++i) {
+            const auto [first, last]{ getVisibleSteps(
+                left.x, right.x, lineSize, static_cast<double>(m_canvas.getWidth())) };
+            for (std::size_t i{ first }; i <= last; ++i) {
                 double t{ static_cast<double>(i) / (lineSize) };
-                auto pixel{ interpolate(left, right, t) };
-                result.push_back(pixel);
+                shadeFragment(interpolate(left, right, t));
             }
         }
         else
-            result.push_back(left);
-
-        return result;
+            shadeFragment(left);
     }
 
-    [[nodiscard]] static std::vector<Vertex>
-    rasterizeOneHorizontalTriangle(const Vertex& left, const Vertex& right, const Vertex& single) {
-        std::vector<Vertex> result{};
-
+    void rasterizeOneHorizontalTriangle(const Vertex& left,
+                                        const Vertex& right,
+                                        const Vertex& single) {
         std::size_t height{ static_cast<std::size_t>(std::abs(left.y - single.y)) };
         if (height > 0) {
             height += 1;
-            for (std::size_t i{}; i <= height; ++i) {
+            const auto [first, last]{ getVisibleSteps(
+                left.y, single.y, height, static_cast<double>(m_canvas.getHeight())) };
+            for (std::size_t i{ first }; i <= last; ++i) {
                 double t{ static_cast<double>(i) / (height) };
                 auto leftVertex{ interpolate(left, single, t) };
                 auto rightVertex{ interpolate(right, single, t) };
 
-                auto line{ rasterizeOneHorizontalLine(leftVertex, rightVertex) };
-                std::move(line.begin(), line.end(), std::back_inserter(result));
+                rasterizeOneHorizontalLine(leftVertex, rightVertex);
             }
         }
         else
-            result = rasterizeOneHorizontalLine(left, right);
-
-        return result;
+            rasterizeOneHorizontalLine(left, right);
     }
 
-    [[nodiscard]] static std::vector<Vertex>
-    rasterizeTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2) {
-        std::vector<Vertex> result{};
+    void rasterizeTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2) {
         std::array<std::reference_wrapper<const Vertex>, 3> vertices{ v0, v1, v2 };
         std::ranges::sort(vertices, [](const Vertex& v1, const Vertex& v2) { return v1.y < v2.y; });
 
@@ -134,13 +299,8 @@ private:
         double tSecondMiddle{ std::abs(middle.y - top.y) / std::abs(top.y - bottom.y) };
         Vertex secondMiddle{ interpolate(top, bottom, tSecondMiddle) };
 
-        auto topTriangle = rasterizeOneHorizontalTriangle(middle, secondMiddle, top);
-        std::move(topTriangle.begin(), topTriangle.end(), std::back_inserter(result));
-
-        auto bottomTriangle = rasterizeOneHorizontalTriangle(middle, secondMiddle, bottom);
-        std::move(bottomTriangle.begin(), bottomTriangle.end(), std::back_inserter(result));
-
-        return result;
+        rasterizeOneHorizontalTriangle(middle, secondMiddle, top);
+        rasterizeOneHorizontalTriangle(middle, secondMiddle, bottom);
     };
 };
 
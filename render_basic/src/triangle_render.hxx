@@ -58,6 +58,16 @@ public:
         return result;
     }
 
+    // The outline of pixelPositionsTriangle, drawn as three lines.
+    void drawTriangle(Position v0, Position v1, Position v2, Color color) {
+        if (!TriangleVertices::isTriangle({ v0, v1, v2 }))
+            throw std::runtime_error{ "Error : drawTriangle : not a triangle"s };
+
+        drawLine(v0, v1, color);
+        drawLine(v1, v2, color);
+        drawLine(v2, v0, color);
+    }
+
     void drawTriangles(const std::vector<Position>& vertices, Color color) {
         if (vertices.size() % 3 != 0)
             throw std::runtime_error{ "Error : drawTriangles : vertices.size() % 3 != 0"s };
@@ -67,10 +77,7 @@ public:
             auto v1{ vertices.at(i * 3 + 1) };
             auto v2{ vertices.at(i * 3 + 2) };
 
-            auto trianglePositions{ pixelPositionsTriangle(v0, v1, v2) };
-            std::ranges::for_each(trianglePositions, [&](const Position position) {
-                m_canvas.setPixel(position, color);
-            });
+            drawTriangle(v0, v1, v2, color);
         }
     }
 };
@@ -0,0 +1,60 @@
+#ifndef RENDER_BASIC_VERTEX_HXX
+#define RENDER_BASIC_VERTEX_HXX
+#include <cstdint>
+#include <stdexcept>
+
+#include "canvas.hxx"
+#include "gfx_program.hxx"
+
+namespace graphics {
+
+// Vertex of the interpolating renders: position in pixels, colour and depth.
+struct Vertex
+{
+    double x{};
+    double y{};
+
+    double r{};
+    double g{};
+    double b{};
+
+    // Depth in [0, 1], 0 nearest. Last, so {x, y, r, g, b} initializers keep working.
+    double z{};
+
+    [[nodiscard]] Position extractPosition() const {
+        return { static_cast<std::size_t>(x), static_cast<std::size_t>(y) };
+    }
+
+    [[nodiscard]] Color extractColor() const {
+        return { static_cast<std::uint8_t>(r),
+                 static_cast<std::uint8_t>(g),
+                 static_cast<std::uint8_t>(b) };
+    }
+};
+
+static double interpolate(const double start, const double end, const double t) {
+    if (t < 0 || t > 1) throw std::runtime_error{ "Error : interpolate : t < 0 || t > 1"s };
+    return start + (end - start) * t;
+}
+
+static Vertex interpolate(const Vertex& start, const Vertex& end, const double t) {
+    return { interpolate(start.x, end.x, t),
+             interpolate(start.y, end.y, t),
+             interpolate(start.r, end.r, t),
+             interpolate(start.g, end.g, t),
+             interpolate(start.b, end.b, t),
+             interpolate(start.z, end.z, t) };
+}
+
+// Draws the interpolated vertex colours as they are.
+class VertexColorGfx final : public IGfx
+{
+public:
+    void setUniforms(const Uniform&) override {}
+    Vertex vertexShader(const Vertex& vertex) override { return vertex; }
+    Color fragmentShader(const Vertex& vertex) override { return vertex.extractColor(); }
+};
+
+} // namespace graphics
+
+#endif // RENDER_BASIC_VERTEX_HXX
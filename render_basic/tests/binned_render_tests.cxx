@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/binned_render.hxx"
+#include "../src/canvas.hxx"
+#include "../src/thread_pool.hxx"
+#include "../src/tile_rasterizer.hxx"
+
+using namespace graphics;
+
+SCENARIO("Thread pool runs every task once", "[thread_pool]") {
+    constexpr std::size_t count{ 1000 };
+
+    for (const std::size_t threads : { 1, 2, 5 }) {
+        ThreadPool pool{ threads };
+        std::vector<std::atomic<int>> runs(count);
+        std::atomic<bool> isThreadValid{ true };
+
+        for (int repeat{}; repeat < 3; ++repeat)
+            pool.parallelFor(count, [&](std::size_t task, std::size_t thread) {
+                ++runs[task];
+                if (thread >= threads) isThreadValid = false;
+            });
+
+        for (const auto& run : runs)
+            REQUIRE(run == 3);
+        REQUIRE(isThreadValid);
+    }
+}
+
+SCENARIO("Thread pool rethrows a task exception", "[thread_pool]") {
+    ThreadPool pool{ 3 };
+    std::atomic<int> runs{};
+
+    REQUIRE_THROWS_AS(pool.parallelFor(100,
+                                       [&](std::size_t task, std::size_t) {
+                                           ++runs;
+                                           if (task == 42) throw std::runtime_error{ "task" };
+                                       }),
+                      std::runtime_error);
+    REQUIRE(runs == 100);
+
+    pool.parallelFor(10, [&](std::size_t, std::size_t) { ++runs; });
+    REQUIRE(runs == 110);
+}
+
+SCENARIO("Binned render draws the same image as the tile rasterizer", "[binned_render]") {
+    constexpr std::size_t width{ 301 };
+    constexpr std::size_t height{ 203 };
+
+    // A fan of overlapping triangles that crosses bin borders and leaves the canvas.
+    std::vector<Vertex> vertices{ { 150.0, 100.0, 255.0, 255.0, 255.0 } };
+    std::vector<std::uint16_t> indices{};
+    constexpr int segments{ 37 };
+    for (int i{}; i <= segments; ++i) {
+        const double angle{ 2.0 * std::numbers::pi * i / segments };
+        vertices.push_back({ 150.0 + 180.0 * std::cos(angle),
+                             100.0 + 130.0 * std::sin(angle * 1.5),
+                             static_cast<double>(i * 7 % 256),
+                             static_cast<double>(i * 31 % 256),
+                             static_cast<double>(i * 73 % 256) });
+        if (i > 0) {
+            indices.push_back(0);
+            indices.push_back(static_cast<std::uint16_t>(i));
+            indices.push_back(static_cast<std::uint16_t>(i + 1));
+        }
+    }
+    indices.push_back(3);
+    indices.push_back(17);
+    indices.push_back(29);
+
+    VertexColorGfx gfx{};
+    Canvas expected{ width, height };
+    TileRasterizer tile{ expected, gfx };
+    tile.drawTriangles(vertices, indices);
+
+    for (const std::size_t threads : { 1, 3, 8 }) {
+        ThreadPool pool{ threads };
+        Canvas canvas{ width, height };
+        BinnedRender render{ canvas, gfx, pool };
+        render.drawTriangles(vertices, indices);
+        REQUIRE(canvas == expected);
+
+        canvas.clear();
+        render.drawTriangles(vertices, indices);
+        REQUIRE(canvas == expected);
+        REQUIRE(render.getStats().shadedFragments == 2 * tile.getStats().shadedFragments);
+    }
+}
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <stdexcept>
 
 #include "../src/canvas.hxx"
 
@@ -61,4 +62,77 @@ SCENARIO("Plain green canvas test", "[canvas]") {
 
 SCENARIO("Plain blue canvas test", "[canvas]") {
     plainColorTest(graphics::blue);
-}
\ No newline at end of file
+}
+
+SCENARIO("Padded canvas keeps its pixels in aligned rows", "[canvas]") {
+    constexpr std::size_t width{ 21 };
+    constexpr std::size_t height{ 5 };
+    graphics::Canvas canvas{ width, height, 16 };
+    REQUIRE(sizeof(graphics::Color) == 4);
+    REQUIRE(canvas.getPitch() == 32);
+    REQUIRE(canvas.getPixels().size() == 32 * height);
+
+    canvas.setPixel({ 20, 3 }, graphics::green);
+    canvas.setPixel({ 0, 4 }, graphics::blue);
+    REQUIRE(canvas.getRow(3)[20] == graphics::green);
+    REQUIRE(canvas.getRow(4)[0] == graphics::blue);
+    REQUIRE(canvas.getRow(3)[21] == graphics::Color{});
+    REQUIRE_THROWS_AS(canvas.setPixel({ width, 0 }, graphics::red), std::out_of_range);
+    REQUIRE_THROWS_AS(canvas.setPixel({ 31, 0 }, graphics::red), std::out_of_range);
+    REQUIRE_THROWS_AS(canvas.setPixel({ 0, height }, graphics::red), std::out_of_range);
+    REQUIRE(canvas.getRow(0)[width] == graphics::Color{});
+
+    std::string_view filename{ "padded.ppm" };
+    canvas.saveImage(filename);
+    REQUIRE(fs::file_size(filename) == "P6\n21 5\n255\n"sv.size() + width * height * 3);
+
+    graphics::Canvas loaded{ 1, 1, 16 };
+    loaded.loadImage(filename);
+    REQUIRE(loaded == canvas);
+    fs::remove(filename);
+}
+
+SCENARIO("Spans, rects and blits fill whole rows", "[canvas]") {
+    constexpr std::size_t width{ 37 };
+    constexpr std::size_t height{ 23 };
+    graphics::Canvas canvas{ width, height, 16 };
+    graphics::Canvas expected{ width, height, 16 };
+
+    canvas.fillSpan({ 3, 4 }, 30, graphics::red);
+    for (std::size_t x{ 3 }; x < 33; ++x)
+        expected.setPixel({ x, 4 }, graphics::red);
+    REQUIRE(canvas == expected);
+
+    canvas.fillRect({ 30, 10 }, 7, 13, graphics::blue);
+    for (std::size_t y{ 10 }; y < height; ++y)
+        for (std::size_t x{ 30 }; x < width; ++x)
+            expected.setPixel({ x, y }, graphics::blue);
+    REQUIRE(canvas == expected);
+
+    graphics::Canvas source{ 5, 3 };
+    source.clear(graphics::green);
+    source.setPixel({ 4, 2 }, graphics::red);
+    canvas.blit(source, { 32, 0 });
+    for (std::size_t y{}; y < 3; ++y)
+        for (std::size_t x{ 32 }; x < width; ++x)
+            expected.setPixel({ x, y }, x == 36 && y == 2 ? graphics::red : graphics::green);
+    REQUIRE(canvas == expected);
+
+    REQUIRE_THROWS_AS(canvas.fillSpan({ 30, 0 }, 8, graphics::red), std::runtime_error);
+    REQUIRE_THROWS_AS(canvas.fillRect({ 0, 20 }, 1, 4, graphics::red), std::runtime_error);
+    REQUIRE_THROWS_AS(canvas.blit(source, { 33, 0 }), std::runtime_error);
+}
+
+SCENARIO("Large clears stream every pixel", "[canvas]") {
+    // Past the streaming size, with rows not starting on a vector boundary.
+    graphics::Canvas canvas{ 1031, 517 };
+    REQUIRE(canvas.getPixels().size() * sizeof(graphics::Color) >=
+            graphics::Canvas::s_streamingFillBytes);
+
+    const graphics::Color color{ 1, 2, 3, 4 };
+    canvas.clear(color);
+    REQUIRE(std::ranges::count(canvas.getPixels(), color) == 1031 * 517);
+    canvas.fillRect({ 1, 1 }, 1029, 515, graphics::blue);
+    REQUIRE(std::ranges::count(canvas.getPixels(), graphics::blue) == 1029 * 515);
+    REQUIRE(canvas.getPixel({ 0, 516 }) == color);
+}
@@ -0,0 +1,161 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/binned_render.hxx"
+#include "../src/canvas.hxx"
+#include "../src/clipper.hxx"
+#include "../src/fragment_batch.hxx"
+#include "../src/pipeline_state.hxx"
+#include "../src/thread_pool.hxx"
+#include "../src/tile_rasterizer.hxx"
+#include "../src/triangle_interpolated.hxx"
+
+using namespace graphics;
+
+namespace {
+
+std::vector<std::array<Vertex, 3>> clipAll(const TriangleClipper<Vertex>& clipper,
+                                           const Vertex& v0,
+                                           const Vertex& v1,
+                                           const Vertex& v2) {
+    std::vector<std::array<Vertex, 3>> triangles{};
+    clipper.clip(v0, v1, v2, [&](const Vertex& a, const Vertex& b, const Vertex& c) {
+        triangles.push_back({ a, b, c });
+    });
+    return triangles;
+}
+
+} // namespace
+
+SCENARIO("Clipper passes visible triangles and culls hidden ones", "[clipper]") {
+    using Result = TriangleClipper<Vertex>::Result;
+    const TriangleClipper<Vertex> clipper{ 40, 30, true };
+
+    const Vertex v0{ -5, 2, 255, 0, 0, 0.5 };
+    const Vertex v1{ 20, -3, 0, 255, 0, 0.5 };
+    const Vertex v2{ 45, 35, 0, 0, 255, 0.5 };
+    const auto inside{ clipAll(clipper, v0, v1, v2) };
+    REQUIRE(inside.size() == 1);
+    REQUIRE(inside[0][0].x == v0.x);
+    REQUIRE(inside[0][2].b == v2.b);
+    REQUIRE(clipper.clip(v0, v1, v2, [](auto&&...) {}) == Result::inside);
+
+    const auto ignore{ [](auto&&...) {} };
+    REQUIRE(clipper.clip({ -1, 0 }, { -10, 5 }, { -3, 29 }, ignore) == Result::culled);
+    REQUIRE(clipper.clip({ 0, 31 }, { 10, 50 }, { 39, 30.5 }, ignore) == Result::culled);
+    REQUIRE(clipper.clip({ 0, 0, 0, 0, 0, -0.5 },
+                         { 10, 0, 0, 0, 0, -0.1 },
+                         { 0, 10, 0, 0, 0, -1.0 },
+                         ignore) == Result::culled);
+
+    const auto nan{ std::numeric_limits<double>::quiet_NaN() };
+    REQUIRE(clipper.clip({ nan, 0 }, { 10, 0 }, { 0, 10 }, ignore) == Result::culled);
+
+    // Depth is only clipped when asked for.
+    const TriangleClipper<Vertex> flat{ 40, 30, false };
+    REQUIRE(flat.clip({ 0, 0, 0, 0, 0, -0.5 },
+                      { 10, 0, 0, 0, 0, -0.1 },
+                      { 0, 10, 0, 0, 0, -1.0 },
+                      ignore) == Result::inside);
+    REQUIRE_THROWS_AS((TriangleClipper<PositionVertex>{ 40, 30, true }), std::runtime_error);
+}
+
+SCENARIO("Triangles past the guard band are clipped to it", "[clipper]") {
+    constexpr std::size_t width{ 64 };
+    constexpr std::size_t height{ 48 };
+    using Result = TriangleClipper<Vertex>::Result;
+    const TriangleClipper<Vertex> clipper{ width, height, false };
+
+    // A vertex far to the right: the pieces stay inside the guard band, and the colour along the
+    // cut edge is interpolated.
+    const Vertex v0{ 0, 0, 0, 0, 0 };
+    const Vertex v1{ 1e7, 0, 200, 0, 0 };
+    const Vertex v2{ 0, 40, 0, 0, 0 };
+    const auto pieces{ clipAll(clipper, v0, v1, v2) };
+    REQUIRE(clipper.clip(v0, v1, v2, [](auto&&...) {}) == Result::clipped);
+    REQUIRE(pieces.size() == 2);
+    for (const auto& piece : pieces)
+        for (const auto& vertex : piece) {
+            REQUIRE(vertex.x <= width - 1 + TriangleClipper<Vertex>::s_guardBand);
+            if (vertex.x > width) REQUIRE(std::abs(vertex.r - 200 * vertex.x / 1e7) < 1e-6);
+        }
+
+    // A triangle around the canvas reaching far past the guard band on every side still covers
+    // every pixel once.
+    Canvas canvas{ width, height };
+    VertexColorBatchGfx gfx{};
+    Rasterizer render{ canvas, gfx };
+    render.drawTriangles({ { -1e9, -1e9, 255, 0, 0 },
+                           { 1e9, -1e9, 255, 0, 0 },
+                           { 0, 1e9, 255, 0, 0 } },
+                         { 0, 1, 2 });
+    REQUIRE(std::ranges::all_of(canvas.getPixels(), [](Color color) { return color == red; }));
+    REQUIRE(render.getStats().clippedTriangles == 1);
+    REQUIRE(render.getStats().shadedFragments == width * height);
+}
+
+SCENARIO("Depth tested pipelines clip triangles to the depth range", "[clipper]") {
+    constexpr std::size_t width{ 80 };
+    constexpr std::size_t height{ 16 };
+
+    // Depth goes from 0.5 at x = 0 to 1.5 at x = 80, it passes the far plane at x = 40.
+    const std::vector<Vertex> vertices{ { 0, 0, 255, 0, 0, 0.5 },
+                                        { 80, 0, 255, 0, 0, 1.5 },
+                                        { 80, 16, 255, 0, 0, 1.5 },
+                                        { 0, 16, 255, 0, 0, 0.5 } };
+    const std::vector<std::uint16_t> indices{ 0, 1, 2, 0, 2, 3 };
+
+    Canvas canvas{ width, height };
+    canvas.attachDepth<std::uint32_t>();
+    VertexColorBatchGfx gfx{};
+    Rasterizer<Vertex, VertexColorBatchGfx, BlendReplace, DepthTest<std::uint32_t>> render{ canvas,
+                                                                                          gfx };
+    render.drawTriangles(vertices, indices);
+
+    for (std::size_t y{}; y < height; ++y)
+        for (std::size_t x{}; x < width; ++x) {
+            if (x == 39 || x == 40) continue;
+            REQUIRE(canvas.getPixel({ x, y }) == (x < 40 ? red : Color{}));
+        }
+    REQUIRE(render.getStats().clippedTriangles == 2);
+
+    // Without a depth test nothing is clipped.
+    Canvas flat{ width, height };
+    Rasterizer{ flat, gfx }.drawTriangles(vertices, indices);
+    REQUIRE(std::ranges::all_of(flat.getPixels(), [](Color color) { return color == red; }));
+}
+
+SCENARIO("Off-screen triangles are culled by every render", "[clipper]") {
+    constexpr std::size_t width{ 32 };
+    constexpr std::size_t height{ 24 };
+    const std::vector<Vertex> vertices{ { -10, -10, 0, 255, 0 }, { -1, 5, 0, 255, 0 },
+                                        { -20, 30, 0, 255, 0 },  { 30, -5, 0, 255, 0 },
+                                        { 40, 20, 0, 255, 0 },   { 10, 30, 0, 255, 0 } };
+    const std::vector<std::uint16_t> indices{ 0, 1, 2, 3, 4, 5 };
+
+    Canvas canvas{ width, height };
+    VertexColorBatchGfx batchGfx{};
+    Rasterizer render{ canvas, batchGfx };
+    render.drawTriangles(vertices, indices);
+    REQUIRE(render.getStats().culledTriangles == 1);
+
+    Canvas binnedCanvas{ width, height };
+    VertexColorGfx gfx{};
+    ThreadPool pool{ 2 };
+    BinnedRender binned{ binnedCanvas, gfx, pool };
+    binned.drawTriangles(vertices, indices);
+    REQUIRE(binned.getStats().culledTriangles == 1);
+    REQUIRE(binnedCanvas.getPixels() == canvas.getPixels());
+
+    // The scanline render drops the fragments of the partly visible triangle off the canvas.
+    Canvas scanline{ width, height };
+    TriangleInterpolateRender interpolated{ scanline, width, height, gfx };
+    REQUIRE_NOTHROW(interpolated.drawTriangles(vertices, indices));
+    REQUIRE(scanline.getPixel({ 31, 10 }) == green);
+}
@@ -0,0 +1,196 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/canvas.hxx"
+#include "../src/depth_buffer.hxx"
+#include "../src/fragment_batch.hxx"
+#include "../src/pipeline_state.hxx"
+#include "../src/tile_rasterizer.hxx"
+
+using namespace graphics;
+
+namespace {
+
+// Two triangles of one colour at one depth over the rectangle.
+void addQuad(std::vector<Vertex>& vertices,
+             std::vector<std::uint16_t>& indices,
+             double left,
+             double top,
+             double right,
+             double bottom,
+             Color color,
+             double depth) {
+    const auto first{ static_cast<std::uint16_t>(vertices.size()) };
+    const auto vertex{ [&](double x, double y) {
+        return Vertex{ x, y, double(color.red), double(color.green), double(color.blue), depth };
+    } };
+    vertices.insert(
+        vertices.end(),
+        { vertex(left, top), vertex(right, top), vertex(right, bottom), vertex(left, bottom) });
+    for (const std::uint16_t index : { 0, 1, 2, 0, 2, 3 })
+        indices.push_back(static_cast<std::uint16_t>(first + index));
+}
+
+// Random flat layers drawn in random order with a depth test look the same as drawn from the far
+// one to the near one without it.
+template <typename T>
+void layersTest() {
+    constexpr std::size_t width{ 123 };
+    constexpr std::size_t height{ 77 };
+    constexpr std::size_t layers{ 40 };
+    std::mt19937 engine{ 5 };
+    std::uniform_real_distribution<double> randX{ -10.0, width + 10.0 };
+    std::uniform_real_distribution<double> randY{ -10.0, height + 10.0 };
+
+    std::vector<double> depths(layers);
+    for (std::size_t i{}; i < layers; ++i)
+        depths[i] = static_cast<double>(i + 1) / (layers + 1);
+    std::ranges::shuffle(depths, engine);
+
+    std::vector<Vertex> vertices{};
+    std::vector<std::uint16_t> indices{};
+    for (const auto depth : depths) {
+        const double x0{ randX(engine) };
+        const double x1{ randX(engine) };
+        const double y0{ randY(engine) };
+        const double y1{ randY(engine) };
+        addQuad(vertices,
+                indices,
+                std::min(x0, x1),
+                std::min(y0, y1),
+                std::max(x0, x1),
+                std::max(y0, y1),
+                Color::generateRandom(),
+                depth);
+    }
+
+    std::vector<std::uint16_t> sorted{};
+    std::vector<std::size_t> order(layers);
+    for (std::size_t i{}; i < layers; ++i)
+        order[i] = i;
+    std::ranges::sort(order, [&](std::size_t a, std::size_t b) { return depths[a] > depths[b]; });
+    for (const auto layer : order)
+        sorted.insert(sorted.end(), indices.begin() + layer * 6, indices.begin() + layer * 6 + 6);
+
+    VertexColorBatchGfx gfx{};
+    Canvas expected{ width, height };
+    Rasterizer{ expected, gfx }.drawTriangles(vertices, sorted);
+
+    Canvas canvas{ width, height };
+    canvas.attachDepth<T>();
+    Rasterizer<Vertex, VertexColorBatchGfx, BlendReplace, DepthTest<T>> render{ canvas, gfx };
+    render.drawTriangles(vertices, indices);
+
+    REQUIRE(canvas.getPixels() == expected.getPixels());
+    const auto empty{ std::ranges::count(expected.getPixels(), Color{}) };
+    REQUIRE(static_cast<std::size_t>(empty) < width * height / 10);
+    REQUIRE(render.getStats().rejectedBlocks > 0);
+}
+
+} // namespace
+
+SCENARIO("Depth buffer keeps the range of every block", "[depth]") {
+    DepthBuffer16 depth{ 20, 10 };
+    REQUIRE(DepthBuffer16::quantize(0.0) == 0);
+    REQUIRE(DepthBuffer16::quantize(0.5) == 32768);
+    REQUIRE(DepthBuffer16::quantize(2.0) == DepthBuffer16::s_far);
+    REQUIRE(DepthBuffer32::quantize(1.0) == DepthBuffer32::s_far);
+
+    depth.getRow(9)[17] = 100;
+    depth.getRow(8)[19] = 200;
+    depth.updateBlock(2, 1);
+    REQUIRE(depth.getBlockMin(2, 1) == 100);
+    REQUIRE(depth.getBlockMax(2, 1) == DepthBuffer16::s_far);
+    REQUIRE(depth.getBlockMin(0, 0) == DepthBuffer16::s_far);
+
+    depth.clear(7);
+    REQUIRE(depth.getBlockMin(2, 1) == 7);
+    REQUIRE(depth.getBlockMax(2, 1) == 7);
+    REQUIRE(std::ranges::all_of(depth.getValues(), [](std::uint16_t value) {
+        return value == 7;
+    }));
+}
+
+SCENARIO("Depth test draws layers in any order like back to front", "[depth]") {
+    layersTest<std::uint16_t>();
+    layersTest<std::uint32_t>();
+}
+
+SCENARIO("Hidden tiles are rejected before shading", "[depth]") {
+    constexpr std::size_t width{ 64 };
+    constexpr std::size_t height{ 48 };
+    std::vector<Vertex> vertices{};
+    std::vector<std::uint16_t> near{};
+    std::vector<std::uint16_t> far{};
+    addQuad(vertices, near, 0, 0, width, height, red, 0.25);
+    addQuad(vertices, far, 0, 0, width, height, blue, 0.75);
+
+    Canvas canvas{ width, height };
+    canvas.attachDepth<std::uint32_t>();
+    VertexColorBatchGfx gfx{};
+    using Render = Rasterizer<Vertex, VertexColorBatchGfx, BlendReplace, DepthTest<std::uint32_t>>;
+    Render render{ canvas, gfx };
+
+    render.drawTriangles(vertices, near);
+    REQUIRE(render.getStats().shadedFragments == width * height);
+
+    render.resetStats();
+    render.drawTriangles(vertices, far);
+    REQUIRE(render.getStats().shadedFragments == 0);
+    REQUIRE(render.getStats().rejectedFragments == 0);
+    REQUIRE(render.getStats().rejectedBlocks > 0);
+    REQUIRE(canvas.getPixel({ 31, 23 }) == red);
+
+    // With the comparison reversed the far quad wins.
+    canvas.clear();
+    canvas.getDepth<std::uint32_t>()->clear(0);
+    Rasterizer<Vertex,
+               VertexColorBatchGfx,
+               BlendReplace,
+               DepthTest<std::uint32_t, DepthCompare::greater>>
+        reversed{ canvas, gfx };
+    reversed.drawTriangles(vertices, far);
+    reversed.drawTriangles(vertices, near);
+    REQUIRE(reversed.getStats().shadedFragments == width * height);
+    REQUIRE(canvas.getPixel({ 31, 23 }) == blue);
+
+    // The depth of another format is not used.
+    using Render16 =
+        Rasterizer<Vertex, VertexColorBatchGfx, BlendReplace, DepthTest<std::uint16_t>>;
+    REQUIRE_THROWS_AS((Render16{ canvas, gfx }), std::runtime_error);
+}
+
+SCENARIO("Depth test resolves intersecting triangles per fragment", "[depth]") {
+    constexpr std::size_t width{ 80 };
+    constexpr std::size_t height{ 40 };
+
+    // Two quads over the canvas, one going away to the right, one coming closer. They cross at
+    // x = 40.
+    const std::vector<Vertex> vertices{ { 0, 0, 255, 0, 0, 0.0 },
+                                        { 80, 0, 255, 0, 0, 1.0 },
+                                        { 80, 40, 255, 0, 0, 1.0 },
+                                        { 0, 40, 255, 0, 0, 0.0 },
+                                        { 0, 0, 0, 0, 255, 1.0 },
+                                        { 80, 0, 0, 0, 255, 0.0 },
+                                        { 80, 40, 0, 0, 255, 0.0 },
+                                        { 0, 40, 0, 0, 255, 1.0 } };
+    const std::vector<std::uint16_t> indices{ 0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7 };
+
+    Canvas canvas{ width, height };
+    canvas.attachDepth<std::uint16_t>();
+    VertexColorBatchGfx gfx{};
+    using Render = Rasterizer<Vertex, VertexColorBatchGfx, BlendReplace, DepthTest<std::uint16_t>>;
+    Render render{ canvas, gfx };
+    render.drawTriangles(vertices, indices);
+
+    for (std::size_t y{}; y < height; ++y)
+        for (std::size_t x{}; x < width; ++x) {
+            if (x == 39 || x == 40) continue;
+            REQUIRE(canvas.getPixel({ x, y }) == (x < 40 ? red : blue));
+        }
+    REQUIRE(render.getStats().rejectedFragments > 0);
+}
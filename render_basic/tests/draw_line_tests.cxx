@@ -139,4 +139,25 @@ SCENARIO("Draw line tests", "[line]") {
 
     CHECK(isLineEqual(start, end));
     CHECK(isLineEqual(end, start));
-}
\ No newline at end of file
+}
+
+SCENARIO("Draw line writes the pixels of its positions", "[line]") {
+    constexpr std::size_t width{ 97 };
+    constexpr std::size_t height{ 61 };
+    Canvas canvas{ width, height, 16 };
+    Canvas expected{ width, height, 16 };
+    LineRender lineRender{ canvas, width, height };
+
+    for (unsigned seed{ 1 }; seed <= 500; ++seed) {
+        const auto start{ Position::generateRandom(width, height, seed) };
+        const auto end{ Position::generateRandom(width, height, seed + 1000) };
+        const auto color{ Color{ static_cast<std::uint8_t>(seed), 0, 255 } };
+
+        lineRender.drawLine(start, end, color);
+        for (const auto position : lineRender.pixelPositions(start, end))
+            expected.setPixel(position, color);
+    }
+    REQUIRE(canvas == expected);
+
+    REQUIRE_THROWS_AS(lineRender.drawLine({ 0, 0 }, { width, 0 }, green), std::runtime_error);
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
+
+#include "../src/frame_exchange.hxx"
+
+using namespace graphics;
+
+namespace {
+
+// Every value of a frame is its number, a frame mixing two numbers was torn.
+using Frame = std::array<int, 4096>;
+
+bool isWhole(const Frame& frame) {
+    return std::ranges::all_of(frame, [&](int value) { return value == frame.front(); });
+}
+
+} // namespace
+
+SCENARIO("Frame exchange hands over the latest frame", "[frame_exchange]") {
+    FrameExchange<int> exchange{ 7 };
+    REQUIRE_FALSE(exchange.acquire());
+    REQUIRE(exchange.getFront() == 7);
+
+    exchange.getBack() = 1;
+    exchange.publish();
+    exchange.getBack() = 2;
+    exchange.publish();
+    REQUIRE(exchange.acquire());
+    REQUIRE(exchange.getFront() == 2);
+    REQUIRE_FALSE(exchange.acquire());
+    REQUIRE(exchange.getFront() == 2);
+
+    exchange.getBack() = 3;
+    exchange.publish();
+    REQUIRE(exchange.acquire());
+    REQUIRE(exchange.getFront() == 3);
+}
+
+SCENARIO("Waiting producer shows every frame whole and in order", "[frame_exchange]") {
+    constexpr int frameCount{ 2000 };
+    FrameExchange<Frame> exchange{};
+
+    std::thread producer{ [&] {
+        for (int frame{ 1 }; frame <= frameCount; ++frame) {
+            exchange.getBack().fill(frame);
+            exchange.publish();
+            exchange.waitTaken();
+        }
+    } };
+
+    std::vector<int> shown{};
+    bool isTorn{};
+    while (shown.empty() || shown.back() < frameCount)
+        if (exchange.acquire()) {
+            isTorn |= !isWhole(exchange.getFront());
+            shown.push_back(exchange.getFront().front());
+        }
+    producer.join();
+
+    REQUIRE_FALSE(isTorn);
+    REQUIRE(shown.size() == frameCount);
+    for (std::size_t i{}; i < shown.size(); ++i)
+        REQUIRE(shown[i] == static_cast<int>(i) + 1);
+}
+
+SCENARIO("Free running producer never tears a frame", "[frame_exchange]") {
+    constexpr int frameCount{ 20000 };
+    FrameExchange<Frame> exchange{};
+
+    std::thread producer{ [&] {
+        for (int frame{ 1 }; frame <= frameCount; ++frame) {
+            exchange.getBack().fill(frame);
+            exchange.publish();
+        }
+    } };
+
+    int last{};
+    bool isTorn{};
+    bool isOrdered{ true };
+    while (last < frameCount)
+        if (exchange.acquire()) {
+            const auto& frame{ exchange.getFront() };
+            isTorn |= !isWhole(frame);
+            isOrdered &= frame.front() > last;
+            last = frame.front();
+        }
+    producer.join();
+
+    REQUIRE_FALSE(isTorn);
+    REQUIRE(isOrdered);
+}
+
+SCENARIO("Closing the exchange wakes a waiting producer", "[frame_exchange]") {
+    FrameExchange<int> exchange{};
+    std::thread producer{ [&] {
+        while (!exchange.isClosed()) {
+            ++exchange.getBack();
+            exchange.publish();
+            exchange.waitTaken();
+        }
+    } };
+
+    while (!exchange.acquire()) {}
+    exchange.close();
+    producer.join();
+    REQUIRE(exchange.isClosed());
+}
@@ -0,0 +1,215 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <vector>
+
+#include "../src/canvas.hxx"
+#include "../src/tile_rasterizer.hxx"
+#include "../src/triangle_interpolated.hxx"
+
+using namespace graphics;
+
+namespace {
+
+// Counts how many times every pixel is shaded.
+class CoverageGfx final : public IGfx
+{
+private:
+    std::size_t m_width{};
+
+public:
+    std::vector<int> hits{};
+
+    CoverageGfx(std::size_t width, std::size_t height) : m_width{ width }, hits(width * height) {}
+
+    void setUniforms(const Uniform&) override {}
+    Vertex vertexShader(const Vertex& vertex) override { return vertex; }
+    Color fragmentShader(const Vertex& vertex) override {
+        const auto x{ static_cast<std::size_t>(vertex.x) };
+        const auto y{ static_cast<std::size_t>(vertex.y) };
+        ++hits.at(y * m_width + x);
+        return vertex.extractColor();
+    }
+};
+
+// The fill rule evaluated for one sample, without tiles or incremental stepping.
+bool isCovered(
+    const Vertex& v0, const Vertex& v1, const Vertex& v2, std::int64_t x, std::int64_t y) {
+    const auto snap{ [](double value) { return std::llround(value * 256.0); } };
+    std::int64_t xs[3]{ snap(v0.x), snap(v1.x), snap(v2.x) };
+    std::int64_t ys[3]{ snap(v0.y), snap(v1.y), snap(v2.y) };
+    const auto area{ (xs[1] - xs[0]) * (ys[2] - ys[0]) - (ys[1] - ys[0]) * (xs[2] - xs[0]) };
+    if (area == 0) return false;
+    if (area < 0) {
+        std::swap(xs[1], xs[2]);
+        std::swap(ys[1], ys[2]);
+    }
+
+    for (int i{}; i < 3; ++i) {
+        const auto ax{ xs[i] };
+        const auto ay{ ys[i] };
+        const auto bx{ xs[(i + 1) % 3] };
+        const auto by{ ys[(i + 1) % 3] };
+        const auto value{ (bx - ax) * (y * 256 - ay) - (by - ay) * (x * 256 - ax) };
+        const bool isTopLeft{ by < ay || (by == ay && bx > ax) };
+        if (value < 0 || (value == 0 && !isTopLeft)) return false;
+    }
+    return true;
+}
+
+// Fills with one colour from the position only, without a vertex colour or a virtual call.
+struct ConstantShader
+{
+    Color color{};
+
+    PositionVertex vertexShader(const PositionVertex& vertex) const { return vertex; }
+    void fragmentShader(const FragmentBatch&, FragmentColors& colors) const { colors.fill(color); }
+};
+
+} // namespace
+
+SCENARIO("Tile rasterizer covers shared edges once", "[tile_rasterizer]") {
+    constexpr std::size_t width{ 64 };
+    constexpr std::size_t height{ 48 };
+    Canvas canvas{ width, height };
+    CoverageGfx gfx{ width, height };
+    TileRasterizer render{ canvas, gfx };
+
+    // A 40x30 rectangle split along its diagonal: the top and left sides are in, the right and
+    // bottom sides belong to the neighbours.
+    const std::vector<Vertex> vertices{
+        { 3, 5, 255, 0, 0 }, { 43, 5, 0, 255, 0 }, { 43, 35, 0, 0, 255 }, { 3, 35, 0, 0, 255 }
+    };
+    render.drawTriangles(vertices, { 0, 1, 2, 0, 2, 3 });
+
+    for (std::size_t y{}; y < height; ++y)
+        for (std::size_t x{}; x < width; ++x) {
+            const bool isInside{ x >= 3 && x < 43 && y >= 5 && y < 35 };
+            REQUIRE(gfx.hits[y * width + x] == (isInside ? 1 : 0));
+        }
+}
+
+SCENARIO("Tile rasterizer matches the fill rule per pixel", "[tile_rasterizer]") {
+    constexpr std::size_t width{ 101 };
+    constexpr std::size_t height{ 67 };
+    std::mt19937 engine{ 7 };
+    std::uniform_real_distribution<double> randX{ -20.0, width + 20.0 };
+    std::uniform_real_distribution<double> randY{ -20.0, height + 20.0 };
+
+    for (int triangle{}; triangle < 200; ++triangle) {
+        const Vertex v0{ randX(engine), randY(engine), 255, 255, 255 };
+        const Vertex v1{ randX(engine), randY(engine), 255, 255, 255 };
+        const Vertex v2{ randX(engine), randY(engine), 255, 255, 255 };
+
+        Canvas canvas{ width, height };
+        CoverageGfx gfx{ width, height };
+        TileRasterizer render{ canvas, gfx };
+        render.rasterizeTriangle(v0, v1, v2);
+
+        for (std::size_t y{}; y < height; ++y)
+            for (std::size_t x{}; x < width; ++x) {
+                const bool isExpected{ isCovered(
+                    v0, v1, v2, static_cast<std::int64_t>(x), static_cast<std::int64_t>(y)) };
+                REQUIRE(gfx.hits[y * width + x] == (isExpected ? 1 : 0));
+            }
+    }
+}
+
+SCENARIO("Tile rasterizer does not depend on the winding", "[tile_rasterizer]") {
+    constexpr std::size_t width{ 80 };
+    constexpr std::size_t height{ 60 };
+    const Vertex v0{ 2.5, 1.25, 255, 0, 0 };
+    const Vertex v1{ 77.0, 30.75, 0, 255, 0 };
+    const Vertex v2{ 12.0, 58.0, 0, 0, 255 };
+
+    Canvas clockwise{ width, height };
+    Canvas counterClockwise{ width, height };
+    VertexColorGfx gfx{};
+    TileRasterizer{ clockwise, gfx }.rasterizeTriangle(v0, v1, v2);
+    TileRasterizer{ counterClockwise, gfx }.rasterizeTriangle(v0, v2, v1);
+
+    REQUIRE(clockwise == counterClockwise);
+}
+
+SCENARIO("Tile rasterizer interpolates vertex colours", "[tile_rasterizer]") {
+    Canvas canvas{ 32, 32 };
+    VertexColorGfx gfx{};
+    TileRasterizer render{ canvas, gfx };
+    render.rasterizeTriangle({ 0, 0, 255, 0, 0 }, { 30, 0, 0, 255, 0 }, { 0, 30, 0, 0, 255 });
+
+    CHECK(canvas.getPixel({ 0, 0 }) == red);
+    CHECK(canvas.getPixel({ 15, 0 }) == Color{ 127, 127, 0 });
+    CHECK(canvas.getPixel({ 0, 15 }) == Color{ 127, 0, 127 });
+    CHECK(canvas.getPixel({ 31, 31 }) == Color{});
+}
+
+SCENARIO("Batch rasterizer shades like the per-fragment adapter", "[tile_rasterizer]") {
+    constexpr std::size_t width{ 97 };
+    constexpr std::size_t height{ 71 };
+    std::mt19937 engine{ 11 };
+    std::uniform_real_distribution<double> randX{ -20.0, width + 20.0 };
+    std::uniform_real_distribution<double> randY{ -20.0, height + 20.0 };
+    std::uniform_real_distribution<double> randColor{ 0.0, 255.0 };
+
+    std::vector<Vertex> vertices{};
+    std::vector<std::uint16_t> indices{};
+    for (std::uint16_t i{}; i < 60; ++i) {
+        vertices.push_back({ randX(engine),
+                             randY(engine),
+                             randColor(engine),
+                             randColor(engine),
+                             randColor(engine) });
+        indices.push_back(i);
+    }
+
+    VertexColorGfx gfx{};
+    Canvas expected{ width, height };
+    TileRasterizer{ expected, gfx }.drawTriangles(vertices, indices);
+
+    // Called directly, the shader inlined.
+    VertexColorBatchGfx batchGfx{};
+    Canvas inlined{ width, height };
+    Rasterizer{ inlined, batchGfx }.drawTriangles(vertices, indices);
+    REQUIRE(inlined == expected);
+
+    // Called through the interface.
+    IBatchGfx& batchInterface{ batchGfx };
+    Canvas virtualCall{ width, height };
+    Rasterizer{ virtualCall, batchInterface }.drawTriangles(vertices, indices);
+    REQUIRE(virtualCall == expected);
+}
+
+SCENARIO("Rasterizer pipelines blend into the canvas", "[tile_rasterizer]") {
+    constexpr std::size_t width{ 50 };
+    constexpr std::size_t height{ 40 };
+    const std::vector<PositionVertex> vertices{ { 2.5, 3.0 }, { 47.0, 11.25 }, { 9.0, 38.5 } };
+    const std::vector<std::uint16_t> indices{ 0, 1, 2 };
+
+    // The coverage of the same triangle through the per-fragment path.
+    Canvas canvas{ width, height };
+    CoverageGfx coverage{ width, height };
+    TileRasterizer{ canvas, coverage }.rasterizeTriangle(
+        { 2.5, 3.0 }, { 47.0, 11.25 }, { 9.0, 38.5 });
+
+    ConstantShader shader{ { 100, 20, 200 } };
+    canvas.clear();
+    Rasterizer<PositionVertex, ConstantShader, BlendAdd> add{ canvas, shader };
+    add.drawTriangles(vertices, indices);
+    add.drawTriangles(vertices, indices);
+    for (std::size_t y{}; y < height; ++y)
+        for (std::size_t x{}; x < width; ++x) {
+            const bool isCovered{ coverage.hits[y * width + x] == 1 };
+            REQUIRE(canvas.getPixel({ x, y }) == (isCovered ? Color{ 200, 40, 255 } : Color{}));
+        }
+
+    shader.color = { 0, 0, 0 };
+    Rasterizer<PositionVertex, ConstantShader, BlendAverage> average{ canvas, shader };
+    average.drawTriangles(vertices, indices);
+    for (std::size_t y{}; y < height; ++y)
+        for (std::size_t x{}; x < width; ++x) {
+            const bool isCovered{ coverage.hits[y * width + x] == 1 };
+            REQUIRE(canvas.getPixel({ x, y }) == (isCovered ? Color{ 100, 20, 127 } : Color{}));
+        }
+
+    REQUIRE_THROWS_AS(average.drawTriangles(vertices, { 0, 1, 3 }), std::runtime_error);
+}
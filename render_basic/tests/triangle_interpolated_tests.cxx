@@ -0,0 +1,147 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <limits>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../src/canvas.hxx"
+#include "../src/tile_rasterizer.hxx"
+#include "../src/triangle_interpolated.hxx"
+
+using namespace graphics;
+
+namespace {
+
+// Counts how many times every pixel is shaded.
+class CoverageGfx final : public IGfx
+{
+private:
+    std::size_t m_width{};
+
+public:
+    std::vector<int> hits{};
+
+    CoverageGfx(std::size_t width, std::size_t height) : m_width{ width }, hits(width * height) {}
+
+    void setUniforms(const Uniform&) override {}
+    Vertex vertexShader(const Vertex& vertex) override { return vertex; }
+    Color fragmentShader(const Vertex& vertex) override {
+        const auto x{ static_cast<std::size_t>(vertex.x) };
+        const auto y{ static_cast<std::size_t>(vertex.y) };
+        ++hits.at(y * m_width + x);
+        return vertex.extractColor();
+    }
+};
+
+// On the 28.4 grid, so the fixed-point render sees the vertices exactly.
+double snapToGrid(double value) {
+    return std::round(value * 16.0) / 16.0;
+}
+
+} // namespace
+
+SCENARIO("Fixed-point render covers samples like the tile rasterizer", "[triangle_interpolated]") {
+    constexpr std::size_t width{ 89 };
+    constexpr std::size_t height{ 61 };
+    std::mt19937 engine{ 13 };
+    std::uniform_real_distribution<double> randX{ -20.0, width + 20.0 };
+    std::uniform_real_distribution<double> randY{ -20.0, height + 20.0 };
+
+    for (int triangle{}; triangle < 200; ++triangle) {
+        std::vector<Vertex> vertices{};
+        for (int i{}; i < 3; ++i)
+            vertices.push_back(
+                { snapToGrid(randX(engine)), snapToGrid(randY(engine)), 255, 255, 255 });
+
+        Canvas fixedCanvas{ width, height };
+        CoverageGfx fixedGfx{ width, height };
+        TriangleInterpolateRender fixed{
+            fixedCanvas, width, height, fixedGfx, RasterMode::fixedPoint
+        };
+        fixed.drawTriangles(vertices, { 0, 1, 2 });
+
+        Canvas tileCanvas{ width, height };
+        CoverageGfx tileGfx{ width, height };
+        TileRasterizer{ tileCanvas, tileGfx }.drawTriangles(vertices, { 0, 1, 2 });
+
+        REQUIRE(fixedGfx.hits == tileGfx.hits);
+    }
+}
+
+SCENARIO("Fixed-point render draws shared edges once", "[triangle_interpolated]") {
+    constexpr std::size_t width{ 64 };
+    constexpr std::size_t height{ 48 };
+    Canvas canvas{ width, height };
+    CoverageGfx gfx{ width, height };
+    TriangleInterpolateRender render{ canvas, width, height, gfx, RasterMode::fixedPoint };
+
+    // A fan around an inner vertex off the pixel grid.
+    const std::vector<Vertex> vertices{ { 30.3125, 21.6875, 255, 255, 255 },
+                                        { 3, 5, 255, 0, 0 },
+                                        { 43, 5, 0, 255, 0 },
+                                        { 43, 35, 0, 0, 255 },
+                                        { 3, 35, 0, 0, 255 } };
+    render.drawTriangles(vertices, { 0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 1 });
+
+    for (std::size_t y{}; y < height; ++y)
+        for (std::size_t x{}; x < width; ++x) {
+            const bool isInside{ x >= 3 && x < 43 && y >= 5 && y < 35 };
+            REQUIRE(gfx.hits[y * width + x] == (isInside ? 1 : 0));
+        }
+}
+
+SCENARIO("Fixed-point render interpolates vertex colours", "[triangle_interpolated]") {
+    Canvas canvas{ 32, 32 };
+    VertexColorGfx gfx{};
+    TriangleInterpolateRender render{ canvas, 32, 32, gfx, RasterMode::fixedPoint };
+    render.drawTriangles({ { 0, 0, 255, 0, 0 }, { 30, 0, 0, 255, 0 }, { 0, 30, 0, 0, 255 } },
+                         { 0, 1, 2 });
+
+    CHECK(canvas.getPixel({ 0, 0 }) == red);
+    CHECK(canvas.getPixel({ 15, 0 }) == Color{ 127, 127, 0 });
+    CHECK(canvas.getPixel({ 0, 15 }) == Color{ 127, 0, 127 });
+    CHECK(canvas.getPixel({ 31, 31 }) == Color{});
+
+    // The winding does not change the image.
+    Canvas reversed{ 32, 32 };
+    TriangleInterpolateRender{ reversed, 32, 32, gfx, RasterMode::fixedPoint }.drawTriangles(
+        { { 0, 0, 255, 0, 0 }, { 30, 0, 0, 255, 0 }, { 0, 30, 0, 0, 255 } }, { 0, 2, 1 });
+    REQUIRE(reversed == canvas);
+}
+
+SCENARIO("Interpolated render clips far vertices and culls non-finite ones",
+         "[triangle_interpolated]") {
+    constexpr std::size_t width{ 48 };
+    constexpr std::size_t height{ 32 };
+    const std::vector<Vertex> far{ { -1e9, 10, 255, 255, 255 },
+                                   { 40, 0, 255, 255, 255 },
+                                   { 40, 30, 255, 255, 255 } };
+
+    Canvas tileCanvas{ width, height };
+    CoverageGfx tileGfx{ width, height };
+    TileRasterizer{ tileCanvas, tileGfx }.drawTriangles(far, { 0, 1, 2 });
+    REQUIRE(tileGfx.hits[10 * width] == 1);
+
+    // Before clipping, the fixed-point render dropped the triangle.
+    Canvas fixedCanvas{ width, height };
+    CoverageGfx fixedGfx{ width, height };
+    TriangleInterpolateRender{ fixedCanvas, width, height, fixedGfx, RasterMode::fixedPoint }
+        .drawTriangles(far, { 0, 1, 2 });
+    REQUIRE(fixedGfx.hits == tileGfx.hits);
+
+    // The scanline render only walks the rows and runs on the canvas.
+    Canvas canvas{ width, height };
+    CoverageGfx gfx{ width, height };
+    TriangleInterpolateRender render{ canvas, width, height, gfx };
+    render.drawTriangles(far, { 0, 1, 2 });
+    REQUIRE(canvas.getPixel({ 0, 10 }) == Color{ 255, 255, 255 });
+
+    const auto nan{ std::numeric_limits<double>::quiet_NaN() };
+    Canvas empty{ width, height };
+    TriangleInterpolateRender{ empty, width, height, gfx }.drawTriangles(
+        { { nan, 10, 255, 255, 255 }, { 40, 0, 255, 255, 255 }, { 40, 30, 255, 255, 255 } },
+        { 0, 1, 2 });
+    REQUIRE(empty == Canvas{ width, height });
+}